@@ -0,0 +1,481 @@
+/**
+ * @file tsp_bench.cpp
+ * @brief End-to-end benchmark of the algorithms
+ * @date October 19, 2026
+ *
+ * Runs every algorithm on the TSPLIB instances of the data directory and on
+ * generated instances, each run in a child process of its own, and writes a
+ * CSV line per run. With --compare, two of those files are checked for
+ * regressions instead.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "cycle.h"
+#include "solver.h"
+#include "synthetic.h"
+
+#ifndef TSP_DATA_DIR
+#define TSP_DATA_DIR "data"
+#endif
+
+#define BENCH_SIDE 10000.0      ///< Side of the square of generated instances
+#define BENCH_COST_TOLERANCE 0.01   ///< Percentage of cost noise of complete runs
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+/// Options of the command line
+struct Options {
+    string pathData;            ///< Directory of the TSPLIB instances
+    vector<string> instances;   ///< Names of the TSPLIB instances
+    vector<string> generated;   ///< Generated instances, as DISTRIBUTION-N
+    vector<string> algorithms;  ///< Names of the algorithms
+    int seeds;                  ///< Runs of each algorithm, seeds 1 to N
+    long timeLimit;             ///< Budget of each run in milliseconds (0: none)
+    char *pathOutput;           ///< Destination of the results (NULL: stdout)
+    char *pathBase;             ///< Results to compare against (NULL: run)
+    char *pathNew;              ///< Results to compare
+    double tolerance;           ///< Percentage of allowed slowdown
+
+    Options()
+    {
+        pathData = TSP_DATA_DIR;
+        instances = split("berlin52,kroA100,a280");
+        generated = split("uniform-1000,uniform-2000");
+        algorithms = split("greedy,rs,ls,vnd,sa,greedyls,greedyls+,bmb,grasp,grasp+,ils,vns,ga,ma,psa,pga");
+        seeds = 1;
+        timeLimit = 5000;
+        pathOutput = NULL;
+        pathBase = NULL;
+        pathNew = NULL;
+        tolerance = 20;
+    }
+
+    static vector<string> split(const string &list)
+    {
+        vector<string> items;
+        std::istringstream stream(list);
+        string item;
+
+        while (std::getline(stream, item, ','))
+            if (!item.empty())
+                items.push_back(item);
+
+        return items;
+    }
+};
+
+/// Outcome of a run, as the child process sends it
+struct Sample {
+    int nodes;                  ///< Size of the instance (0 if it failed)
+    float cost;                 ///< Length of the tour found
+    float optimum;              ///< Length of the optimal tour (0 if unknown)
+    long wall;                  ///< Milliseconds of the search
+    long steps;                 ///< Steps of the search (see Algorithms::solve())
+};
+
+/// Line of a results file
+struct Record {
+    double cost;
+    long wall;
+    long rss;
+    bool limited;
+};
+
+static bool config(int argc, char **argv, Options &options);
+static void printHelp();
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Check the name of a generated instance
+ * @param name Name of an instance.
+ * @return Whether it is DISTRIBUTION-N, with at least 3 nodes.
+ */
+static bool generated(const string &name)
+{
+    Tsp::Synthetic::Distribution distribution;
+    const size_t dash = name.rfind('-');
+
+    return dash != string::npos && Tsp::Synthetic::parse(name.substr(0, dash).c_str(), distribution) && atoi(name.c_str() + dash + 1) >= 3;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Load an instance
+ * @param data Destination.
+ * @param name Name of a TSPLIB instance, or DISTRIBUTION-N (see Synthetic).
+ * @param options Data directory.
+ * @param optimum Destination of the length of the optimal tour, if shipped
+ *        or known (0 otherwise).
+ * @return Whether it was loaded.
+ */
+static bool load(Cycle &data, const string &name, const Options &options, float &optimum)
+{
+    const string path = options.pathData + "/" + name;
+
+    optimum = 0;
+
+    if (generated(name)) {
+        Tsp::Synthetic::Distribution distribution;
+        const size_t dash = name.rfind('-');
+        const int size = atoi(name.c_str() + dash + 1);
+
+        Tsp::Synthetic::parse(name.substr(0, dash).c_str(), distribution);
+
+        // Same points for every run and every build
+        Tsp::Synthetic synthetic(distribution, size, size, BENCH_SIDE);
+        const vector<Instance::Vertex> vertices = synthetic.points();
+
+        optimum = (float)synthetic.optimum();
+        return data.loadVertices(vertices.data(), size);
+    }
+
+    if (!data.loadTsp((path + ".tsp").c_str()))
+        return false;
+
+    if (access((path + ".opt.tour").c_str(), R_OK) == 0) {
+        Cycle tour(data);
+
+        if (tour.loadTour((path + ".opt.tour").c_str()))
+            optimum = tour.getCost();
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Run an algorithm in a child process
+ * @param name Instance to load.
+ * @param settings Algorithm and parameters.
+ * @param options Data directory.
+ * @param sample Destination of the outcome.
+ * @param rss Destination of the peak resident memory of the child, in KiB.
+ *
+ * The child loads the instance itself, so that the peak memory and any crash
+ * belong to that run alone.
+ *
+ * @return Whether the run finished.
+ */
+static bool measure(const string &name, const Algorithms::Settings &settings, const Options &options, Sample &sample, long &rss)
+{
+    struct rusage usage;
+    int channel[2], status;
+    pid_t child;
+
+    memset(&sample, 0, sizeof(sample));
+
+    if (pipe(channel) < 0 || (child = fork()) < 0) {
+        perror("tsp_bench");
+        return false;
+    }
+
+    if (child == 0) {
+        Cycle data;
+
+        close(channel[0]);
+
+        if (load(data, name, options, sample.optimum)) {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            Algorithms::solve(data, settings, NULL, &sample.steps);
+            sample.wall = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            sample.nodes = data.getSize();
+            sample.cost = data.getCost();
+        }
+
+        _exit(write(channel[1], &sample, sizeof(sample)) == (ssize_t)sizeof(sample) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    close(channel[1]);
+
+    const bool received = read(channel[0], &sample, sizeof(sample)) == (ssize_t)sizeof(sample);
+
+    close(channel[0]);
+
+    if (wait4(child, &status, 0, &usage) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS || !received)
+        return false;
+
+    rss = usage.ru_maxrss;
+    return sample.nodes > 0;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Run the whole benchmark
+ * @param options Instances, algorithms and destination.
+ * @return Whether every run finished.
+ */
+static bool run(const Options &options)
+{
+    vector<string> names;
+    std::ofstream file;
+    bool success = true;
+
+    if (options.pathOutput != NULL) {
+        file.open(options.pathOutput);
+
+        if (!file) {
+            cerr << "Could not write " << options.pathOutput << endl;
+            return false;
+        }
+    }
+
+    std::ostream &output = options.pathOutput != NULL ? file : cout;
+
+    names = options.instances;
+    output.precision(9);
+
+    names.insert(names.end(), options.generated.begin(), options.generated.end());
+
+    output << "# instance,nodes,algorithm,seed,cost,optimum,gap_pct,wall_ms,steps,steps_per_s,peak_rss_kb,limited" << endl;
+
+    for (size_t i = 0; i < names.size(); i++) {
+        for (size_t j = 0; j < options.algorithms.size(); j++) {
+            for (int seed = 1; seed <= options.seeds; seed++) {
+                Algorithms::Algorithm algorithm;
+                Sample sample;
+                long rss = 0;
+
+                Algorithms::parse(options.algorithms[j].c_str(), algorithm);
+                Algorithms::Settings settings(algorithm, seed);
+                settings.timeLimit = options.timeLimit;
+
+                cerr << names[i] << " " << options.algorithms[j] << " " << seed << "..." << endl;
+
+                if (!measure(names[i], settings, options, sample, rss)) {
+                    cerr << "Run failed: " << names[i] << " " << options.algorithms[j] << " " << seed << endl;
+                    success = false;
+                    continue;
+                }
+
+                output << names[i] << "," << sample.nodes << "," << options.algorithms[j] << "," << seed << ","
+                       << sample.cost << ",";
+
+                if (sample.optimum > 0)
+                    output << sample.optimum << "," << (sample.cost - sample.optimum) / sample.optimum * 100;
+                else
+                    output << ",";
+
+                output << "," << sample.wall << "," << sample.steps << ","
+                       << (sample.wall > 0 ? (long)(sample.steps * 1000.0 / sample.wall) : 0) << "," << rss << ","
+                       << (options.timeLimit > 0 && sample.wall >= options.timeLimit ? 1 : 0) << endl;
+            }
+        }
+    }
+
+    return success;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Read a results file
+ * @param path File written by run().
+ * @param records Destination, by instance, algorithm and seed.
+ * @return Whether it could be read.
+ */
+static bool read(const char *path, std::map<string, Record> &records)
+{
+    std::ifstream file(path);
+    string line;
+
+    if (!file) {
+        cerr << "Could not open " << path << endl;
+        return false;
+    }
+
+    while (std::getline(file, line)) {
+        vector<string> cells;
+        std::istringstream stream(line);
+        string cell;
+        Record record;
+
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        while (std::getline(stream, cell, ','))
+            cells.push_back(cell);
+
+        if (cells.size() < 12) {
+            cerr << "Invalid line in " << path << ": " << line << endl;
+            return false;
+        }
+
+        record.cost = atof(cells[4].c_str());
+        record.wall = atol(cells[7].c_str());
+        record.rss = atol(cells[10].c_str());
+        record.limited = atoi(cells[11].c_str()) != 0;
+        records[cells[0] + "," + cells[2] + "," + cells[3]] = record;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Flag the regressions between two results files
+ * @param options Files and tolerance.
+ *
+ * Complete runs are deterministic, so their cost may not grow beyond float
+ * noise, while runs cut by the time limit may lose up to the tolerance. Wall
+ * time (of complete runs) and peak memory may grow up to the tolerance.
+ *
+ * @return Whether there was no regression.
+ */
+static bool compare(const Options &options)
+{
+    std::map<string, Record> base, current;
+    int regressions = 0, matched = 0;
+
+    if (!read(options.pathBase, base) || !read(options.pathNew, current))
+        return false;
+
+    cout << "# regression,instance,algorithm,seed,metric,base,new" << endl;
+
+    for (std::map<string, Record>::const_iterator it = base.begin(); it != base.end(); ++it) {
+        std::map<string, Record>::const_iterator other = current.find(it->first);
+        const double slack = 1 + options.tolerance / 100;
+        const Record &before = it->second;
+
+        if (other == current.end()) {
+            cout << "regression," << it->first << ",missing,," << endl;
+            regressions++;
+            continue;
+        }
+
+        const Record &after = other->second;
+        const double costSlack = before.limited || after.limited ? slack : 1 + BENCH_COST_TOLERANCE / 100;
+
+        matched++;
+
+        if (after.cost > before.cost * costSlack) {
+            cout << "regression," << it->first << ",cost," << before.cost << "," << after.cost << endl;
+            regressions++;
+        }
+
+        if (!before.limited && !after.limited && after.wall > before.wall * slack && after.wall - before.wall > 10) {
+            cout << "regression," << it->first << ",wall_ms," << before.wall << "," << after.wall << endl;
+            regressions++;
+        }
+
+        if (after.rss > before.rss * slack) {
+            cout << "regression," << it->first << ",peak_rss_kb," << before.rss << "," << after.rss << endl;
+            regressions++;
+        }
+    }
+
+    cerr << matched << " runs compared, " << regressions << " regressions." << endl;
+    return regressions == 0;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    if (!config(argc, argv, options)) {
+        printHelp();
+        return EXIT_FAILURE;
+    }
+
+    if (options.pathBase != NULL)
+        return compare(options) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    return run(options) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool config(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 == argc)
+            return false;
+
+        if (!strcmp(argv[i], "--data"))
+            options.pathData = argv[++i];
+        else if (!strcmp(argv[i], "--instances"))
+            options.instances = Options::split(argv[++i]);
+        else if (!strcmp(argv[i], "--generate")) {
+            options.generated = Options::split(argv[++i]);
+
+            // Plain sizes are uniform instances
+
+            for (size_t j = 0; j < options.generated.size(); j++) {
+                if (options.generated[j].find('-') == string::npos)
+                    options.generated[j] = "uniform-" + options.generated[j];
+
+                if (!generated(options.generated[j]))
+                    return false;
+            }
+        } else if (!strcmp(argv[i], "--algorithms")) {
+            Algorithms::Algorithm algorithm;
+
+            options.algorithms = Options::split(argv[++i]);
+
+            for (size_t j = 0; j < options.algorithms.size(); j++)
+                if (!Algorithms::parse(options.algorithms[j].c_str(), algorithm) || algorithm == Algorithms::None)
+                    return false;
+        } else if (!strcmp(argv[i], "--seeds")) {
+            if ((options.seeds = atoi(argv[++i])) < 1)
+                return false;
+        } else if (!strcmp(argv[i], "--time-limit")) {
+            if ((options.timeLimit = (long)(strtod(argv[++i], NULL) * 1000)) < 0)
+                return false;
+        } else if (!strcmp(argv[i], "--output"))
+            options.pathOutput = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance")) {
+            if ((options.tolerance = strtod(argv[++i], NULL)) < 0)
+                return false;
+        } else if (!strcmp(argv[i], "--compare") && i + 2 < argc) {
+            options.pathBase = argv[++i];
+            options.pathNew = argv[++i];
+        } else
+            return false;
+    }
+
+    return true;
+}
+
+static void printHelp()
+{
+    cout << "How to use:\n"
+         << "  tsp_bench [--data DIR] [--instances LIST] [--generate LIST] [--algorithms LIST]\n"
+         << "            [--seeds N] [--time-limit SEC] [--output FILE]\n"
+         << "  tsp_bench --compare BASE NEW [--tolerance PCT]\n"
+         << endl
+         << "Run each algorithm on the TSPLIB instances and on generated ones, and write a\n"
+         << "CSV line per run, or compare two of those files and fail on regressions.\n"
+         << endl
+         << "OPTIONS:\n"
+         << "  --data DIR        Directory of the TSPLIB instances. Def: the source tree.\n"
+         << "  --instances LIST  Names of the instances, with a .opt.tour file for the gap.\n"
+         << "                    Def: berlin52,kroA100,a280.\n"
+         << "  --generate LIST   Generated instances, as DISTRIBUTION-N or N for uniform\n"
+         << "                    (empty for none). Distributions: uniform, clustered, grid\n"
+         << "                    and road. Def: 1000,2000.\n"
+         << "  --algorithms LIST Algorithms to run, as in tsp -a. Def: all of them.\n"
+         << "  --seeds N         Run each algorithm with seeds 1 to N. Def: 1.\n"
+         << "  --time-limit SEC  Budget of each run (0 for none). Def: 5.\n"
+         << "  --output FILE     Write the results to FILE. Def: standard output.\n"
+         << "  --compare BASE NEW  Flag costs, times and memory of NEW worse than BASE.\n"
+         << "  --tolerance PCT   Allowed slowdown and memory growth. Def: 20.\n";
+}
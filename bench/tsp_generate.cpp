@@ -0,0 +1,114 @@
+/**
+ * @file tsp_generate.cpp
+ * @brief Generator of synthetic TSPLIB instances
+ * @date October 19, 2026
+ *
+ * Writes a seeded instance of uniform, clustered, grid or road-like cities,
+ * streaming the points to the file, so that instances up to tens of millions
+ * of cities take little memory.
+ */
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include "synthetic.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+/// Options of the command line
+struct Options {
+    Tsp::Synthetic::Distribution distribution;
+    long count;             ///< Number of cities
+    unsigned long seed;     ///< Seed of the points
+    double side;            ///< Side of the square of the points
+    const char *pathOutput; ///< Destination ("-" for stdout)
+
+    Options()
+    {
+        distribution = Tsp::Synthetic::Uniform;
+        count = 0;
+        seed = 1;
+        side = SYNTHETIC_SIDE;
+        pathOutput = "-";
+    }
+};
+
+static bool config(int argc, char **argv, Options &options);
+static void printHelp();
+
+int main(int argc, char **argv)
+{
+    Options options;
+
+    if (!config(argc, argv, options)) {
+        printHelp();
+        return EXIT_FAILURE;
+    }
+
+    Tsp::Synthetic synthetic(options.distribution, options.count, options.seed, options.side);
+    const std::string name = std::string(argv[argc - 2]) + "-" + argv[argc - 1];
+
+    return synthetic.write(options.pathOutput, name.c_str()) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool config(int argc, char **argv, Options &options)
+{
+    char *end;
+
+    if (argc < 3)
+        return false;
+
+    for (int i = 1; i < argc - 2; i++) {
+        if (i + 1 == argc - 2)
+            return false;
+
+        if (!strcmp(argv[i], "--seed"))
+            options.seed = strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--side")) {
+            if ((options.side = strtod(argv[++i], NULL)) <= 0)
+                return false;
+        } else if (!strcmp(argv[i], "--output"))
+            options.pathOutput = argv[++i];
+        else
+            return false;
+    }
+
+    if (!Tsp::Synthetic::parse(argv[argc - 2], options.distribution))
+        return false;
+
+    // Counts may end in k or M
+
+    options.count = strtol(argv[argc - 1], &end, 10);
+
+    if (!strcmp(end, "k"))
+        options.count *= 1000;
+    else if (!strcmp(end, "M"))
+        options.count *= 1000000;
+    else if (*end != '\0')
+        return false;
+
+    return options.count > 0;
+}
+
+static void printHelp()
+{
+    cout << "How to use:\n"
+         << "  tsp_generate [--seed N] [--side X] [--output FILE] DISTRIBUTION COUNT\n"
+         << endl
+         << "Write a TSPLIB instance of COUNT cities (e.g. 5000, 100k, 10M) in a square,\n"
+         << "streaming the points. Compile it with tsp --compile to load it faster.\n"
+         << endl
+         << "OPTIONS:\n"
+         << "  --seed N       Seed of the points. Def: 1.\n"
+         << "  --side X       Side of the square. Def: 1000000.\n"
+         << "  --output FILE  Destination. Def: standard output.\n"
+         << endl
+         << "DISTRIBUTIONS:\n"
+         << "  uniform    Uniform in the square\n"
+         << "  clustered  Normal clouds around a center per 100 cities\n"
+         << "  grid       Square lattice, with a known optimal tour\n"
+         << "  road       Towns joined by roads, a town per 1000 cities\n";
+}
@@ -0,0 +1,370 @@
+/**
+ * @file tsp_microbench.cpp
+ * @brief Microbenchmarks of the primitives of Cycle
+ * @date October 19, 2026
+ *
+ * Times the primitives that the algorithms call in their inner loops, in
+ * nanoseconds per call, on uniform random instances whose distance matrix
+ * ranges from the L1 cache to main memory. Operands are drawn beforehand from
+ * a fixed seed, so runs are comparable and the generator is only timed where
+ * it is part of the primitive.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include "cycle.h"
+#include "algorithms.h"
+#include "synthetic.h"
+
+#define BENCH_OPERANDS 65536    ///< Operands drawn for each primitive (power of 2)
+#define BENCH_MIN_TIME 20       ///< Milliseconds of each repetition, at least
+#define BENCH_SIDE 10000.0      ///< Side of the square of the instances
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+/// Options of the command line
+struct Options {
+    vector<int> sizes;          ///< Nodes of the instances
+    Instance::Layout layout;    ///< Storage layout of the distance matrix
+    unsigned int seed;          ///< Seed of the instances and operands
+    int repetitions;            ///< Timings of each primitive (the median is kept)
+    vector<std::string> only;   ///< Primitives to run (empty for all)
+
+    Options()
+    {
+        // Matrices of 8 KiB, 512 KiB, 8 MiB and 512 MiB in the packed layout
+
+        sizes.push_back(64);
+        sizes.push_back(512);
+        sizes.push_back(2048);
+        sizes.push_back(16384);
+        layout = Instance::Packed;
+        seed = 1;
+        repetitions = 5;
+    }
+};
+
+/// State shared by the primitives on an instance
+struct Fixture {
+    Cycle data;                 ///< Tour on the instance
+    Cycle other;                ///< Another tour on the same instance
+    vector<Instance::Vertex> vertices;  ///< Nodes of the instance
+    vector<int> first;          ///< Random positions (or nodes)
+    vector<int> second;         ///< Random positions (or nodes), or lengths
+    Instance scratch;           ///< Instance rebuilt by updateDistances
+    Algorithms::Generator generator;
+    float sink;                 ///< Results, so that no call is dropped
+};
+
+/// Primitive under test: runs @p count calls
+typedef void (*Kernel)(Fixture &fixture, long count);
+
+static bool config(int argc, char **argv, Options &options);
+static void printHelp();
+
+//------------------------------------------------------------------------------
+// Kernels: operands are taken in order, wrapping around
+
+/// Exchange two random nodes, updating the cost
+static void swapNodes(Fixture &fixture, long count)
+{
+    for (long k = 0; k < count; k++) {
+        const int index = k & (BENCH_OPERANDS - 1);
+        fixture.data.swap(fixture.first[index], fixture.second[index]);
+    }
+
+    fixture.sink += fixture.data.getCost();
+}
+
+/// Reverse a subpath of 2 to 6 nodes, as annealing does
+static void invert(Fixture &fixture, long count)
+{
+    for (long k = 0; k < count; k++) {
+        const int index = k & (BENCH_OPERANDS - 1);
+        fixture.data.invertSubpath(fixture.first[index], fixture.second[index]);
+    }
+
+    fixture.sink += fixture.data.getCost();
+}
+
+/// Shuffle a subpath of 6 nodes, as the descendant search does
+static void shuffle(Fixture &fixture, long count)
+{
+    for (long k = 0; k < count; k++)
+        fixture.data.shuffleSubpath(6, fixture.generator);
+
+    fixture.sink += fixture.data.edgeAt(0);
+}
+
+/// Sum the whole tour
+static void updateCost(Fixture &fixture, long count)
+{
+    for (long k = 0; k < count; k++) {
+        fixture.data.updateCost();
+        fixture.sink += fixture.data.getCost();
+    }
+}
+
+/// Copy the whole tour of another cycle
+static void setPath(Fixture &fixture, long count)
+{
+    for (long k = 0; k < count; k++) {
+        fixture.data.setPath(k & 1 ? fixture.data : fixture.other);
+        fixture.sink += fixture.data.edgeAt(k % fixture.data.getSize());
+    }
+}
+
+/// Distance between two random nodes
+static void distance(Fixture &fixture, long count)
+{
+    float sum = 0;
+
+    for (long k = 0; k < count; k++) {
+        const int index = k & (BENCH_OPERANDS - 1);
+        sum += fixture.data.distance(fixture.first[index], fixture.second[index]);
+    }
+
+    fixture.sink += sum;
+}
+
+/// Build the whole distance matrix (through Instance::loadVertices())
+static void updateDistances(Fixture &fixture, long count)
+{
+    for (long k = 0; k < count; k++) {
+        fixture.scratch.loadVertices(fixture.vertices.data(), (int)fixture.vertices.size(), fixture.data.getLayout());
+        fixture.sink += fixture.scratch.distance(0, fixture.scratch.getSize() - 1);
+    }
+}
+
+/// Integer in [0, size[
+static void randomInteger(Fixture &fixture, long count)
+{
+    const int size = fixture.data.getSize();
+    int sum = 0;
+
+    for (long k = 0; k < count; k++)
+        sum += Algorithms::random(fixture.generator, size);
+
+    fixture.sink += sum;
+}
+
+/// Primitives, in the order they are run
+static const struct {
+    const char *name;
+    Kernel kernel;
+} kernels[] = {
+    { "swap", swapNodes },
+    { "invertSubpath", invert },
+    { "shuffleSubpath", shuffle },
+    { "updateCost", updateCost },
+    { "setPath", setPath },
+    { "distance", distance },
+    { "updateDistances", updateDistances },
+    { "random", randomInteger }
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Prepare an instance and the operands of the primitives
+ * @param fixture Destination.
+ * @param size Number of nodes.
+ * @param options Layout and seed.
+ * @param kernel Primitive the operands are for.
+ * @return Whether the instance was loaded.
+ */
+static bool prepare(Fixture &fixture, int size, const Options &options, Kernel kernel)
+{
+    fixture.vertices = Tsp::Synthetic(Tsp::Synthetic::Uniform, size, options.seed, BENCH_SIDE).points();
+
+    if (!fixture.data.loadVertices(fixture.vertices.data(), size, options.layout))
+        return false;
+
+    fixture.generator = Algorithms::Generator(options.seed);
+    fixture.data.shufflePath(fixture.generator);
+    fixture.data.updateCost();
+    fixture.other = fixture.data;
+    fixture.other.shufflePath(fixture.generator);
+    fixture.other.updateCost();
+    fixture.first.resize(BENCH_OPERANDS);
+    fixture.second.resize(BENCH_OPERANDS);
+    fixture.sink = 0;
+
+    for (int k = 0; k < BENCH_OPERANDS; k++) {
+        if (kernel == invert) {
+            fixture.second[k] = Algorithms::random(fixture.generator, 5) + 2;
+            fixture.first[k] = Algorithms::random(fixture.generator, size - fixture.second[k]);
+        } else {
+            fixture.first[k] = Algorithms::random(fixture.generator, size);
+
+            do
+                fixture.second[k] = Algorithms::random(fixture.generator, size);
+            while (fixture.second[k] == fixture.first[k]);
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Time a primitive
+ * @param fixture Instance and operands.
+ * @param kernel Primitive.
+ * @param repetitions Number of timings.
+ * @param total Destination of the calls made in the timings.
+ *
+ * The number of calls per timing doubles until it takes BENCH_MIN_TIME, so
+ * that the clock is negligible.
+ *
+ * @return Median nanoseconds per call.
+ */
+static double measure(Fixture &fixture, Kernel kernel, int repetitions, long &total)
+{
+    vector<double> samples;
+    long count = 1;
+
+    // Calibrate, which also warms up the caches
+
+    while (true) {
+        const Clock::time_point start = Clock::now();
+        kernel(fixture, count);
+
+        if (Clock::now() - start >= std::chrono::milliseconds(BENCH_MIN_TIME))
+            break;
+
+        count *= 2;
+    }
+
+    total = 0;
+
+    for (int r = 0; r < repetitions; r++) {
+        const Clock::time_point start = Clock::now();
+        kernel(fixture, count);
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count);
+        total += count;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    float sink = 0;
+
+    if (!config(argc, argv, options)) {
+        printHelp();
+        return EXIT_FAILURE;
+    }
+
+    cout << "# primitive,nodes,ns_per_op,ops" << endl;
+    cout << std::fixed << std::setprecision(2);
+
+    for (size_t i = 0; i < options.sizes.size(); i++) {
+        for (size_t j = 0; j < sizeof(kernels) / sizeof(kernels[0]); j++) {
+            Fixture fixture;
+            long total;
+
+            if (!options.only.empty() && std::find(options.only.begin(), options.only.end(), kernels[j].name) == options.only.end())
+                continue;
+
+            if (!prepare(fixture, options.sizes[i], options, kernels[j].kernel))
+                return EXIT_FAILURE;
+
+            const double time = measure(fixture, kernels[j].kernel, options.repetitions, total);
+
+            cout << kernels[j].name << "," << options.sizes[i] << "," << time << "," << total << endl;
+            sink += fixture.sink;
+        }
+    }
+
+    // Keep the results alive
+    return sink == -1.0f ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static bool config(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 == argc)
+            return false;
+
+        if (!strcmp(argv[i], "--sizes")) {
+            std::istringstream list(argv[++i]);
+            std::string item;
+
+            options.sizes.clear();
+
+            while (std::getline(list, item, ',')) {
+                if (atoi(item.c_str()) < 8)
+                    return false;
+
+                options.sizes.push_back(atoi(item.c_str()));
+            }
+        } else if (!strcmp(argv[i], "--layout")) {
+            if (!strcmp(argv[++i], "packed"))
+                options.layout = Instance::Packed;
+            else if (!strcmp(argv[i], "square"))
+                options.layout = Instance::Square;
+            else if (!strcmp(argv[i], "tiled"))
+                options.layout = Instance::Tiled;
+            else
+                return false;
+        } else if (!strcmp(argv[i], "--seed"))
+            options.seed = strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--repetitions")) {
+            if ((options.repetitions = atoi(argv[++i])) < 1)
+                return false;
+        } else if (!strcmp(argv[i], "--only")) {
+            std::istringstream list(argv[++i]);
+            std::string item;
+
+            while (std::getline(list, item, ','))
+                options.only.push_back(item);
+        } else
+            return false;
+    }
+
+    return !options.sizes.empty();
+}
+
+static void printHelp()
+{
+    cout << "How to use:\n"
+         << "  tsp_microbench [--sizes LIST] [--layout LAYOUT] [--seed N] [--repetitions N]\n"
+         << "                 [--only LIST]\n"
+         << endl
+         << "Time the primitives of Cycle on uniform random instances, and write the median\n"
+         << "nanoseconds per call of each one as CSV.\n"
+         << endl
+         << "OPTIONS:\n"
+         << "  --sizes LIST      Nodes of the instances. Def: 64,512,2048,16384.\n"
+         << "  --layout LAYOUT   Storage of the distance matrix (packed, square, tiled).\n"
+         << "  --seed N          Seed of the instances and operands. Def: 1.\n"
+         << "  --repetitions N   Timings of each primitive. Def: 5.\n"
+         << "  --only LIST       Primitives to time. Def: all of them.\n"
+         << endl
+         << "PRIMITIVES:\n"
+         << "  swap             Exchange two random nodes\n"
+         << "  invertSubpath    Reverse 2 to 6 nodes at a random position\n"
+         << "  shuffleSubpath   Shuffle 6 nodes at a random position\n"
+         << "  updateCost       Sum the whole tour\n"
+         << "  setPath          Copy the whole tour\n"
+         << "  distance         Distance between two random nodes\n"
+         << "  updateDistances  Build the whole distance matrix\n"
+         << "  random           Integer below the number of nodes\n";
+}
@@ -3,8 +3,10 @@
 #ifndef ALGORITHMS_H
 #define	ALGORITHMS_H
 
-#include <random>
 #include <climits>
+#include <cstdint>
+#include "generator.h"
+#include "deadline.h"
 
 class Cycle;
 
@@ -15,6 +17,8 @@ enum NeighborGenerator { Swap, Invert };
 
 enum Scheme { Generational, Stationary };
 
+enum Crossover { Segment, OX, PMX, EAX, EAXBlock };
+
 enum Hybridization {
     Everygen_Twochrom,
     Everygen_Everychrom,
@@ -24,44 +28,70 @@ enum Hybridization {
 
 enum Topology { Star, Ring };
 
-// Integer in the range [0, max[
-inline int random(std::mt19937 &generator, int max)
+class Checkpoint;
+
+// Integer in the range [0, max[ (Lemire's multiply-shift, without bias)
+template <class G>
+inline int random(G &generator, int max)
 {
-    register unsigned int value;
+    uint64_t product = (uint64_t)(uint32_t)(generator() >> 32) * (uint32_t)max;
+
+    if ((uint32_t)product < (uint32_t)max) {
+        const uint32_t threshold = -(uint32_t)max % (uint32_t)max;
+
+        while ((uint32_t)product < threshold)
+            product = (uint64_t)(uint32_t)(generator() >> 32) * (uint32_t)max;
+    }
+
+    return (int)(product >> 32);
+}
 
-    do {
-        value = generator();
-    } while (value == generator.max());
+// Real number in the range [0, 1[
+template <class G>
+inline double uniform(G &generator)
+{
+    return (generator() >> 11) * (1.0 / 9007199254740992.0);
+}
 
-    return (int)((double)value / generator.max() * max);
+// Fill a buffer with real numbers in the range [0, 1[
+template <class G>
+inline void uniforms(G &generator, double *buffer, int count)
+{
+    for (int i = 0; i < count; i++)
+        buffer[i] = (generator() >> 11) * (1.0 / 9007199254740992.0);
 }
 
 void greedy(Cycle &data);
 
-int localSearch(Cycle &data);
-void localSearch(Cycle &data, unsigned int seed);
-void localSearch(Cycle &data, std::mt19937 &generator);
+int localSearch(Cycle &data, Deadline &deadline);
+void localSearch(Cycle &data, unsigned int seed, Deadline &deadline);
+void localSearch(Cycle &data, Generator &generator, Deadline &deadline);
+
+int localRepair(Cycle &data, const int *nodes, int count, Deadline &deadline);
 
-void randomSearch(Cycle &data, int count, unsigned int seed);
-void descendantSearch(Cycle &data, int count, unsigned int seed);
+void randomSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline);
+void descendantSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline);
+void descendantSearch(Cycle &data, int count, Generator &generator, Deadline &deadline);
 
-void simulatedAnnealing(Cycle &data, int count, unsigned int seed, NeighborGenerator neighbor);
-void simulatedAnnealing(Cycle &data, int count, std::mt19937 &generator, NeighborGenerator neighbor);
+void simulatedAnnealing(Cycle &data, int count, unsigned int seed, NeighborGenerator neighbor, Deadline &deadline, Checkpoint *checkpoint);
+void simulatedAnnealing(Cycle &data, int count, Generator &generator, NeighborGenerator neighbor, bool warm, Deadline &deadline, Checkpoint *checkpoint);
 
-void greedy_bl(Cycle &data);
-void greedy_blext(Cycle &data, int count, unsigned int seed);
+void greedy_bl(Cycle &data, Deadline &deadline);
+void greedy_blext(Cycle &data, int count, unsigned int seed, Deadline &deadline);
 
-void basicMultibootSearch(Cycle &data, int count, unsigned int seed);
-void grasp(Cycle &data, int count, unsigned int seed);
-void graspExt(Cycle &data, int count, unsigned int seed);
-void iteratedLocalSearch(Cycle &data, int count, unsigned int seed);
-void variableSearch(Cycle &data, int count, unsigned int seed);
+void basicMultibootSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline);
+void grasp(Cycle &data, int count, unsigned int seed, Deadline &deadline);
+void graspExt(Cycle &data, int count, unsigned int seed, Deadline &deadline);
+void iteratedLocalSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline);
+void iteratedLocalSearch(Cycle &data, int count, Generator &generator, Deadline &deadline);
+void variableSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline);
+void variableSearch(Cycle &data, int count, Generator &generator, Deadline &deadline);
 
-void genetic(Cycle &data, int size, int count, Scheme scheme, unsigned int seed);
-void memetic(Cycle &data, int size, int count, Hybridization hybridization, unsigned int seed);
+void genetic(Cycle &data, int size, int count, Scheme scheme, Crossover crossover, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint);
+void memetic(Cycle &data, int size, int count, Hybridization hybridization, Crossover crossover, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint);
 
-void parallelAnnealing(Cycle &data, int processes, int count, int migrLatency, unsigned int seed);
-void parallelGenetic(Cycle &data, int processes, int size, int count, int migrLatency, Topology topology, unsigned int seed);
+void parallelAnnealing(Cycle &data, int processes, int count, int migrLatency, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint);
+void parallelGenetic(Cycle &data, int processes, int size, int count, int migrLatency, Topology topology, Crossover crossover, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint);
 }
 
 #endif	// ALGORITHMS_H
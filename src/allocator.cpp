@@ -0,0 +1,367 @@
+/**
+ * @file allocator.cpp
+ * @brief Definition of the Allocator namespace
+ * @date October 18, 2026
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "allocator.h"
+
+/// Bookkeeping stored in the cache line that precedes every block
+struct Header {
+    size_t capacity;    ///< Usable bytes of the block
+    size_t mapped;      ///< Length of the mapping (0 if taken from the heap)
+    bool huge;          ///< Whether the mapping uses reserved huge pages
+};
+
+static std::atomic<int> pages(Allocator::Normal);
+static std::atomic<bool> firstTouch(false);
+
+static std::atomic<size_t> nAllocations(0);
+static std::atomic<size_t> nReleases(0);
+static std::atomic<size_t> nBytes(0);
+static std::atomic<size_t> nPeak(0);
+static std::atomic<size_t> nMapped(0);
+static std::atomic<size_t> nHuge(0);
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Header of a block
+ * @param ptr Pointer returned by allocate().
+ * @return Bookkeeping of the block.
+ */
+static inline Header * header(void *ptr)
+{
+    return (Header*)((char*)ptr - ALLOC_ALIGNMENT);
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Account a new block
+ * @param capacity Usable bytes of the block.
+ */
+static void count(size_t capacity)
+{
+    size_t bytes = nBytes += capacity;
+    size_t peak = nPeak;
+
+    nAllocations++;
+
+    while (bytes > peak && !nPeak.compare_exchange_weak(peak, bytes));
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief CPUs of each NUMA node
+ * @return Allowed CPUs of every node that has any, read from sysfs. Empty if
+ * the topology is unknown.
+ */
+static std::vector<cpu_set_t> nodeCpus()
+{
+    std::vector<cpu_set_t> nodes;
+    DIR *dir = opendir("/sys/devices/system/node");
+    struct dirent *entry;
+    cpu_set_t allowed;
+
+    if (dir == NULL)
+        return nodes;
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) < 0) {
+        closedir(dir);
+        return nodes;
+    }
+
+    while ((entry = readdir(dir)) != NULL) {
+        std::ifstream file;
+        std::string list;
+        cpu_set_t cpus;
+        int id;
+        char extra;
+
+        if (sscanf(entry->d_name, "node%d%c", &id, &extra) != 1)
+            continue;
+
+        file.open(std::string("/sys/devices/system/node/") + entry->d_name + "/cpulist");
+
+        if (!std::getline(file, list))
+            continue;
+
+        // Ranges such as "0-3,8-11"
+
+        CPU_ZERO(&cpus);
+
+        for (const char *p = list.c_str(); *p != '\0'; ) {
+            char *end;
+            long first = strtol(p, &end, 10);
+            long last = first;
+
+            if (end == p)
+                break;
+
+            if (*end == '-')
+                last = strtol(end + 1, &end, 10);
+
+            for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+                if (CPU_ISSET(cpu, &allowed))
+                    CPU_SET(cpu, &cpus);
+
+            if (*end != ',')
+                break;
+
+            p = end + 1;
+        }
+
+        if (CPU_COUNT(&cpus) > 0)
+            nodes.push_back(cpus);
+    }
+
+    closedir(dir);
+    return nodes;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Touch the pages of a mapping from every node
+ * @param base Start of the mapping.
+ * @param length Length of the mapping.
+ *
+ * The mapping is divided in huge-page chunks that are dealt in turn to one
+ * thread per node, pinned to the CPUs of that node. Without a known topology,
+ * or on a single node, one unpinned thread per core is used. Writing a zero
+ * keeps the contents of an anonymous mapping.
+ */
+static void touch(char *base, size_t length)
+{
+    static const std::vector<cpu_set_t> nodes = nodeCpus();
+    const size_t chunks = (length + ALLOC_HUGE_PAGE - 1) / ALLOC_HUGE_PAGE;
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const bool pinned = nodes.size() > 1;
+    size_t nThreads = pinned ? nodes.size() : std::thread::hardware_concurrency();
+    std::vector<std::thread> threads;
+
+    if (nThreads > chunks)
+        nThreads = chunks;
+
+    for (size_t t = 0; t < nThreads; t++) {
+        threads.push_back(std::thread([ = ]() {
+            // If the thread cannot be pinned, its pages land wherever it runs
+
+            if (pinned)
+                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &nodes[t]);
+
+            for (size_t c = t; c < chunks; c += nThreads) {
+                size_t end = (c + 1) * ALLOC_HUGE_PAGE < length ? (c + 1) * ALLOC_HUGE_PAGE : length;
+
+                for (size_t i = c * ALLOC_HUGE_PAGE; i < end; i += page)
+                    ((volatile char*)base)[i] = 0;
+            }
+        }));
+    }
+
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Map a large block
+ * @param bytes Size requested.
+ * @return Start of the mapping, with the header filled, or NULL on failure.
+ */
+static Header * map(size_t bytes)
+{
+    const size_t length = (bytes + ALLOC_ALIGNMENT + ALLOC_HUGE_PAGE - 1) & ~(size_t)(ALLOC_HUGE_PAGE - 1);
+    void *base = MAP_FAILED;
+    bool huge = false;
+
+#ifdef MAP_HUGETLB
+    if (pages == Allocator::Explicit) {
+        base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        huge = (base != MAP_FAILED);
+    }
+#endif
+
+    if (base == MAP_FAILED) {
+        base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (base == MAP_FAILED)
+            return NULL;
+
+#ifdef MADV_HUGEPAGE
+        if (pages != Allocator::Normal)
+            madvise(base, length, MADV_HUGEPAGE);
+#endif
+    }
+
+    if (firstTouch)
+        touch((char*)base, length);
+
+    Header *h = (Header*)base;
+    h->capacity = length - ALLOC_ALIGNMENT;
+    h->mapped = length;
+    h->huge = huge;
+
+    nMapped += length;
+
+    if (huge)
+        nHuge += length;
+
+    return h;
+}
+
+//------------------------------------------------------------------------------
+
+namespace Allocator
+{
+
+void configure(Pages pages, bool firstTouch)
+{
+    ::pages = pages;
+    ::firstTouch = firstTouch;
+}
+
+//------------------------------------------------------------------------------
+
+void * allocate(size_t bytes, bool zero)
+{
+    Header *h;
+
+    if (bytes >= ALLOC_LARGE) {
+
+        // Anonymous mappings are already filled with zeros
+
+        if ((h = map(bytes)) == NULL)
+            return NULL;
+    } else {
+        void *base;
+
+        if (posix_memalign(&base, ALLOC_ALIGNMENT, bytes + ALLOC_ALIGNMENT))
+            return NULL;
+
+        h = (Header*)base;
+        h->capacity = bytes;
+        h->mapped = 0;
+        h->huge = false;
+
+        if (zero)
+            memset((char*)base + ALLOC_ALIGNMENT, 0, bytes);
+    }
+
+    count(h->capacity);
+    return (char*)h + ALLOC_ALIGNMENT;
+}
+
+//------------------------------------------------------------------------------
+
+void * reallocate(void *ptr, size_t bytes)
+{
+    if (ptr == NULL)
+        return allocate(bytes);
+
+    const size_t capacity = header(ptr)->capacity;
+
+    if (bytes <= capacity)
+        return ptr;
+
+#ifdef MREMAP_MAYMOVE
+    Header *h = header(ptr);
+
+    // A mapping grows by moving its pages, not by copying them
+
+    if (h->mapped && !h->huge) {
+        const size_t length = (bytes + ALLOC_ALIGNMENT + ALLOC_HUGE_PAGE - 1) & ~(size_t)(ALLOC_HUGE_PAGE - 1);
+        void *base = mremap(h, h->mapped, length, MREMAP_MAYMOVE);
+
+        if (base != MAP_FAILED) {
+            h = (Header*)base;
+            nMapped += length - h->mapped;
+            nBytes -= h->capacity;
+            h->capacity = length - ALLOC_ALIGNMENT;
+            h->mapped = length;
+            nAllocations--;     // Still the same block for the statistics
+            count(h->capacity);
+            return (char*)h + ALLOC_ALIGNMENT;
+        }
+    }
+#endif
+
+    void *block = allocate(bytes);
+
+    if (block != NULL) {
+        memcpy(block, ptr, capacity);
+        release(ptr);
+    }
+
+    return block;
+}
+
+//------------------------------------------------------------------------------
+
+void release(void *ptr)
+{
+    if (ptr == NULL)
+        return;
+
+    Header *h = header(ptr);
+
+    nBytes -= h->capacity;
+    nReleases++;
+
+    if (h->mapped) {
+        nMapped -= h->mapped;
+
+        if (h->huge)
+            nHuge -= h->mapped;
+
+        munmap(h, h->mapped);
+    } else
+        free(h);
+}
+
+//------------------------------------------------------------------------------
+
+Stats stats()
+{
+    Stats s;
+
+    s.allocations = nAllocations;
+    s.releases = nReleases;
+    s.bytes = nBytes;
+    s.peak = nPeak;
+    s.mapped = nMapped;
+    s.huge = nHuge;
+
+    return s;
+}
+
+//------------------------------------------------------------------------------
+
+void printStats(std::ostream &stream)
+{
+    Stats s = stats();
+
+    stream << "Allocations: " << s.allocations << " (" << s.releases << " released)\n"
+           << "In use:      " << s.bytes / 1024 << " KiB\n"
+           << "Peak:        " << s.peak / 1024 << " KiB\n"
+           << "Mapped:      " << s.mapped / 1024 << " KiB (" << s.huge / 1024 << " KiB on huge pages)\n";
+}
+
+}
@@ -0,0 +1,122 @@
+/**
+ * @file allocator.h
+ * @brief Declaration of the Allocator namespace
+ * @date October 18, 2026
+ */
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <cstddef>
+#include <iosfwd>
+
+#define ALLOC_ALIGNMENT 64          ///< Alignment of every block (cache line)
+#define ALLOC_HUGE_PAGE (2 << 20)   ///< Size of a huge page
+#define ALLOC_LARGE ALLOC_HUGE_PAGE ///< Blocks from this size are mapped
+
+/**
+ * @brief Memory allocator
+ *
+ * Every large buffer of the application (vertices, paths, distance matrices)
+ * is obtained here. Blocks are aligned to a cache line, and blocks of at least
+ * ALLOC_LARGE bytes are mapped directly from the system so that they can be
+ * backed by huge pages.
+ */
+namespace Allocator
+{
+
+/// Huge page policy for large blocks
+enum Pages {
+    Normal,         ///< Regular pages
+    Transparent,    ///< Ask for transparent huge pages (madvise)
+    Explicit        ///< Reserved huge pages (MAP_HUGETLB), else transparent
+};
+
+/// Allocation statistics
+struct Stats {
+    size_t allocations; ///< Number of blocks allocated
+    size_t releases;    ///< Number of blocks released
+    size_t bytes;       ///< Bytes currently in use
+    size_t peak;        ///< Maximum of bytes in use
+    size_t mapped;      ///< Bytes currently mapped from the system
+    size_t huge;        ///< Bytes currently mapped on reserved huge pages
+};
+
+/**
+ * @brief Set the policy for large blocks
+ * @param pages Huge page policy.
+ * @param firstTouch Whether new large blocks are touched from every node.
+ *
+ * On NUMA machines, a page is placed on the node of the core that first writes
+ * it. With @p firstTouch, the pages of a new large block are interleaved over
+ * the nodes instead of landing on the node of the allocating thread: each node
+ * writes its share from a thread pinned to its CPUs. The nodes are read from
+ * /sys/devices/system/node, so the placement is best effort. Where they are
+ * unknown, or a thread cannot be pinned, the kernel decides where it runs.
+ */
+void configure(Pages pages, bool firstTouch);
+
+/**
+ * @brief Allocate a block
+ * @param bytes Size of the block.
+ * @param zero Whether the block must be filled with zeros.
+ * @return Pointer aligned to ALLOC_ALIGNMENT, or NULL on failure.
+ */
+void * allocate(size_t bytes, bool zero = false);
+
+/**
+ * @brief Resize a block
+ * @param ptr Block obtained from allocate(), or NULL.
+ * @param bytes New size of the block.
+ *
+ * The block is only moved if it must grow beyond its capacity, and a mapped
+ * block is moved by remapping its pages instead of copying them. The contents
+ * are preserved up to the smaller size.
+ *
+ * @return Pointer to the block, or NULL on failure (@p ptr remains valid).
+ */
+void * reallocate(void *ptr, size_t bytes);
+
+/**
+ * @brief Release a block
+ * @param ptr Block obtained from allocate(), or NULL.
+ */
+void release(void *ptr);
+
+/**
+ * @brief Get allocation statistics
+ * @return Snapshot of the counters.
+ */
+Stats stats();
+
+/**
+ * @brief Print allocation statistics
+ * @param stream Output stream.
+ */
+void printStats(std::ostream &stream);
+
+/**
+ * @brief Allocate an array
+ * @param count Number of elements.
+ * @param zero Whether the array must be filled with zeros.
+ * @return Typed pointer to the new block.
+ */
+template <class T> inline T * allocate(size_t count, bool zero = false)
+{
+    return (T*)allocate(sizeof(T) * count, zero);
+}
+
+/**
+ * @brief Resize an array
+ * @param ptr Array obtained from allocate(), or NULL.
+ * @param count New number of elements.
+ * @return Typed pointer to the array.
+ */
+template <class T> inline T * reallocate(T *ptr, size_t count)
+{
+    return (T*)reallocate((void*)ptr, sizeof(T) * count);
+}
+
+}
+
+#endif // ALLOCATOR_H
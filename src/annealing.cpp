@@ -2,46 +2,94 @@
 
 #include "algorithms.h"
 #include <cmath>
+#include <algorithm>
 #include "cycle.h"
+#include "checkpoint.h"
 
 #define P 0.249175  ///< Multiple of the initial temperature
 #define NCOOL 20    ///< Number of iterations at each temperature state
 #define TEMPEND 0.1 ///< Final temperature
+#define CHECKSTEPS 1024 ///< Temperature states between checks of the checkpoint interval
+#define WARM_EDGES 0.3  ///< Initial temperature of a warm start, in mean edges of the tour
 
-/// Solution acceptance condition
-inline static bool accept(double delta, double temperature, std::mt19937 &gen)
+/// Solution acceptance condition, given a chance in [0, 1[
+inline static bool accept(double delta, double temperature, double chance)
 {
     if (delta < 0.0)
         return true;
     else
-        return (double)gen() / gen.max() < exp(-delta / temperature);
+        return chance < exp(-delta / temperature);
+}
+
+/**
+ * @brief Save the state of the annealing
+ * @param checkpoint Destination.
+ * @param data Current cycle.
+ * @param auxCycle Candidate cycle (its cost drifts apart from that of @p data).
+ * @param generator Random stream.
+ * @param k Moves done.
+ * @param temperature Current temperature.
+ * @param beta Cooling factor.
+ */
+static void save(Algorithms::Checkpoint &checkpoint, const Cycle &data, const Cycle &auxCycle, const Algorithms::Generator &generator, int k, double temperature, double beta)
+{
+    checkpoint.begin(data);
+    checkpoint.put(k);
+    checkpoint.put(temperature);
+    checkpoint.put(beta);
+    checkpoint.put(generator);
+    checkpoint.put(data);
+    checkpoint.put(auxCycle);
+    checkpoint.commit();
 }
 
 namespace Algorithms
 {
-void simulatedAnnealing(Cycle &data, int count, unsigned int seed, NeighborGenerator neighbor)
+void simulatedAnnealing(Cycle &data, int count, unsigned int seed, NeighborGenerator neighbor, Deadline &deadline, Checkpoint *checkpoint)
 {
-    std::mt19937 generator(seed);
+    Generator generator(seed);
 
     // Generate initial solution
     data.shufflePath(generator);
 
-    simulatedAnnealing(data, count, generator, neighbor);
+    simulatedAnnealing(data, count, generator, neighbor, false, deadline, checkpoint);
 }
 
-void simulatedAnnealing(Cycle &data, int count, std::mt19937 &generator, NeighborGenerator neighbor)
+void simulatedAnnealing(Cycle &data, int count, Generator &generator, NeighborGenerator neighbor, bool warm, Deadline &deadline, Checkpoint *checkpoint)
 {
     const int nMax = count * data.getSize();
+    int k = 0;
     double temperature;
+    double beta;
+    double chances[NCOOL];      // Acceptance draws of a temperature state
     Cycle &bestCycle = data;    // Cycle to optimize
     Cycle auxCycle = bestCycle; // Candidate cycle
 
-    // Set temperature
+    // Set temperature: a random tour starts hot, but a given tour is assumed
+    // to be good, and it would be scrambled at that temperature
+
+    if (warm)
+        temperature = std::max(TEMPEND, WARM_EDGES * bestCycle.getCost() / bestCycle.getSize());
+    else
+        temperature = P * bestCycle.getCost();
+
+    beta = (temperature - TEMPEND) / (nMax * temperature * TEMPEND);
+
+    if (checkpoint != NULL && checkpoint->restore()) {
+        checkpoint->get(k);
+        checkpoint->get(temperature);
+        checkpoint->get(beta);
+        checkpoint->get(generator);
+        checkpoint->get(data);
+        checkpoint->get(auxCycle);
+    }
 
-    temperature = P * bestCycle.getCost();
-    const double beta = (temperature - TEMPEND) / (nMax * temperature * TEMPEND);
+    for (; k < nMax && !deadline.expired(); k += NCOOL) {
+        if (checkpoint != NULL && k % (NCOOL * CHECKSTEPS) == 0 && checkpoint->due())
+            save(*checkpoint, data, auxCycle, generator, k, temperature, beta);
+
+        uniforms(generator, chances, NCOOL);
 
-    for (int k = 0; k < nMax; k += NCOOL) {
         switch (neighbor) {
         case Swap:
             int i, j;
@@ -57,7 +105,7 @@ void simulatedAnnealing(Cycle &data, int count, std::mt19937 &generator, Neighbo
 
                 auxCycle.swap(i, j);
 
-                if (accept(auxCycle.getCost() - bestCycle.getCost(), temperature, generator)) {
+                if (accept(auxCycle.getCost() - bestCycle.getCost(), temperature, chances[n])) {
                     bestCycle.setPath(auxCycle);
                 } else {
                     auxCycle.swap(i, j);
@@ -77,7 +125,7 @@ void simulatedAnnealing(Cycle &data, int count, std::mt19937 &generator, Neighbo
                 begin = random(generator, auxCycle.getSize() - count);
                 auxCycle.invertSubpath(begin, count);
 
-                if (accept(auxCycle.getCost() - bestCycle.getCost(), temperature, generator)) {
+                if (accept(auxCycle.getCost() - bestCycle.getCost(), temperature, chances[n])) {
                     bestCycle.setPath(auxCycle);
                 } else {
                     auxCycle.invertSubpath(begin, count);
@@ -87,5 +135,8 @@ void simulatedAnnealing(Cycle &data, int count, std::mt19937 &generator, Neighbo
 
         temperature /= (1.0 + beta * temperature);
     }
+
+    if (checkpoint != NULL)
+        save(*checkpoint, data, auxCycle, generator, k, temperature, beta);
 }
 }
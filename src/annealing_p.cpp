@@ -3,30 +3,102 @@
 #include "algorithms.h"
 #include <iostream>
 #include "cycle.h"
+#include "checkpoint.h"
 
 using namespace std;
 
 namespace Algorithms
 {
 
-void parallelAnnealing(Cycle &data, int processes, int count, int migrLatency, unsigned int seed)
+/**
+ * @brief Save the state of the parallel annealing
+ * @param checkpoint Destination.
+ * @param data Best cycle.
+ * @param cycles Cycle of each replica.
+ * @param streams Random stream of each replica.
+ * @param processes Number of replicas.
+ * @param k Cooling rounds done.
+ */
+static void save(Checkpoint &checkpoint, const Cycle &data, const Cycle *cycles, const Generator *streams, int processes, int k)
+{
+    checkpoint.begin(data);
+    checkpoint.put(k);
+    checkpoint.put(data);
+
+    for (int i = 0; i < processes; i++) {
+        checkpoint.put(streams[i]);
+        checkpoint.put(cycles[i]);
+    }
+
+    checkpoint.commit();
+}
+
+void parallelAnnealing(Cycle &data, int processes, int count, int migrLatency, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint)
 {
     const int times = count / migrLatency; // (count * n) / (migrLatency * n)
-    std::mt19937 generator(seed);
+    int k = 1;
+    int savedK = k;
+    bool whole = true;
+    bool staged = false;
     Cycle &bestCycle = data;
     Cycle *cycles = new Cycle[processes];
+    Generator *streams = new Generator[processes];
+    Cycle *savedCycles = NULL;
+    Generator *savedStreams = NULL;
+    Cycle savedBest(data);
+
+    // Each replica draws from its own stream of the seed
 
     for (int i = 0; i < processes; i++) {
+        streams[i] = Generator(seed, i);
         cycles[i] = data;
-        cycles[i].shufflePath(generator);
+
+        if (!warm)
+            cycles[i].shufflePath(streams[i]);
+    }
+
+    if (checkpoint != NULL && checkpoint->restore()) {
+        checkpoint->get(k);
+        checkpoint->get(data);
+
+        for (int i = 0; i < processes; i++) {
+            checkpoint->get(streams[i]);
+            checkpoint->get(cycles[i]);
+        }
+    }
+
+    // The copy of the state at the start of each round reuses this storage
+
+    if (checkpoint != NULL) {
+        savedCycles = new Cycle[processes];
+        savedStreams = new Generator[processes];
+
+        for (int i = 0; i < processes; i++)
+            savedCycles[i] = cycles[i];
     }
 
-    for (int k = 1; k < times; k++) {
+    for (; k < times && !deadline.expired(); k++) {
+        // A round may be stopped halfway, so the state at its start is saved
+        // if a checkpoint is due, and copied otherwise
+
+        if (checkpoint != NULL && checkpoint->due()) {
+            save(*checkpoint, data, cycles, streams, processes, k);
+            staged = false;
+        } else if (checkpoint != NULL) {
+            for (int i = 0; i < processes; i++) {
+                savedCycles[i].setPath(cycles[i]);
+                savedStreams[i] = streams[i];
+            }
+
+            savedBest.setPath(data);
+            savedK = k;
+            staged = true;
+        }
 
         // Cool
 
         for (int i = 0; i < processes; i++)
-            simulatedAnnealing(cycles[i], 1, generator, Swap);
+            simulatedAnnealing(cycles[i], 1, streams[i], Swap, warm, deadline, NULL);
 
         // Search best cycle
 
@@ -34,6 +106,14 @@ void parallelAnnealing(Cycle &data, int processes, int count, int migrLatency, u
             if (cycles[i].getCost() < bestCycle.getCost())
                 bestCycle.setPath(cycles[i]);
 
+        // Replicas stopped halfway leave a state that an uninterrupted run
+        // would never reach: the start of this round is saved instead
+
+        if (deadline.expired()) {
+            whole = false;
+            break;
+        }
+
         // Update status
 
         if (k < times - 1)
@@ -45,7 +125,15 @@ void parallelAnnealing(Cycle &data, int processes, int count, int migrLatency, u
 #endif
     }
 
+    if (checkpoint != NULL && whole)
+        save(*checkpoint, data, cycles, streams, processes, k);
+    else if (checkpoint != NULL && staged)
+        save(*checkpoint, savedBest, savedCycles, savedStreams, processes, savedK);
+
     delete [] cycles;
+    delete [] streams;
+    delete [] savedCycles;
+    delete [] savedStreams;
 }
 
 }
@@ -0,0 +1,371 @@
+/**
+ * @file batch.cpp
+ * @brief Definition of the Batch class
+ * @date October 19, 2026
+ */
+
+#include "batch.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief CPU time of the calling thread
+ * @return Milliseconds.
+ */
+static double threadTime()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1000.0 + now.tv_nsec / 1e6;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Split a CSV line
+ * @param line Cells separated by commas (no quoting).
+ * @return Cells, with the surrounding spaces removed.
+ */
+static std::vector<std::string> split(const std::string &line)
+{
+    std::vector<std::string> cells;
+    size_t start = 0;
+
+    while (true) {
+        const size_t comma = line.find(',', start);
+        std::string cell = line.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+        const size_t first = cell.find_first_not_of(" \t");
+
+        cell = first == std::string::npos ? "" : cell.substr(first, cell.find_last_not_of(" \t") - first + 1);
+        cells.push_back(cell);
+
+        if (comma == std::string::npos)
+            return cells;
+
+        start = comma + 1;
+    }
+}
+
+namespace Tsp
+{
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Batch::Batch(int workers, Instance::Layout layout, Instance::Order order, ResultCache *results)
+{
+    this->workers = workers > 0 ? workers : 1;
+    this->layout = layout;
+    this->order = order;
+    this->results = results;
+    next = 0;
+    interruptions = 0;
+}
+
+//------------------------------------------------------------------------------
+// Read a manifest
+
+bool Batch::load(const char *path)
+{
+    const bool standard = std::string(path) == "-";
+    std::ifstream file;
+    std::vector<std::string> header;
+    std::string line;
+    bool csv = false, first = true;
+    int number = 0;
+
+    if (!standard)
+        file.open(path);
+
+    std::istream &input = standard ? std::cin : file;
+
+    if (!input) {
+        std::cerr << "Could not open manifest " << path << std::endl;
+        return false;
+    }
+
+    while (std::getline(input, line)) {
+        number++;
+
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+            line.pop_back();
+
+        if (line.empty() || line[line.find_first_not_of(" \t")] == '#')
+            continue;
+
+        // A first line with commas and no field is the header of a CSV
+
+        if (first) {
+            first = false;
+
+            if ((csv = line.find(',') != std::string::npos && line.find('=') == std::string::npos)) {
+                header = split(line);
+                continue;
+            }
+        }
+
+        if (!csv) {
+            if (!add(line, number))
+                return false;
+
+            continue;
+        }
+
+        const std::vector<std::string> cells = split(line);
+        std::string fields;
+
+        if (cells.size() > header.size()) {
+            std::cerr << "Manifest line " << number << ": more cells than the header" << std::endl;
+            return false;
+        }
+
+        for (size_t i = 0; i < cells.size(); i++)
+            if (!cells[i].empty())
+                fields += header[i] + "=" + cells[i] + " ";
+
+        if (!add(fields, number))
+            return false;
+    }
+
+    if (jobs.empty()) {
+        std::cerr << "Manifest " << path << " has no jobs" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Add a job of the manifest
+
+bool Batch::add(const std::string &fields, int line)
+{
+    std::istringstream tokens(fields);
+    std::string field, key;
+    Job job;
+
+    job.request.id = std::to_string(line);
+    job.request.settings = Algorithms::Settings(Algorithms::Greedy, (unsigned int)time(NULL));
+    job.done = false;
+    job.cost = 0;
+
+    if (!parse(fields, job.request, field)) {
+        std::cerr << "Manifest line " << line << ": invalid field " << field << std::endl;
+        return false;
+    }
+
+    if (job.request.path.empty() == job.request.points.empty()) {
+        std::cerr << "Manifest line " << line << ": give either tsp or points" << std::endl;
+        return false;
+    }
+
+    // The seeds of the same settings are summarized together
+
+    while (tokens >> field) {
+        key = field.substr(0, field.find('='));
+
+        if (key != "id" && key != "tsp" && key != "points" && key != "seed" && key != "out")
+            job.settings += (job.settings.empty() ? "" : " ") + field;
+    }
+
+    const std::string problem = job.request.path.empty() ? "points" : job.request.path;
+    const std::string group = problem + "\n" + job.settings;
+    std::map<std::string, size_t>::iterator it = groupIndex.find(group);
+
+    if (it == groupIndex.end()) {
+        it = groupIndex.insert(std::make_pair(group, groups.size())).first;
+        groups.push_back(Group());
+        groups.back().path = problem;
+        groups.back().settings = job.settings;
+    }
+
+    job.group = it->second;
+
+    if (!job.request.path.empty()) {
+        std::shared_ptr<Source> &source = sources[job.request.path];
+
+        if (!source) {
+            source = std::make_shared<Source>();
+            source->pending = 0;
+        }
+
+        source->pending++;
+        job.source = source;
+    }
+
+    jobs.push_back(job);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Run the jobs
+
+bool Batch::run(std::ostream &output)
+{
+    std::vector<std::thread> threads;
+
+    output << "# job,id,tsp,settings,seed,cost,wall_ms,cpu_ms,steps,cached,tour" << std::endl;
+    next = 0;
+    interruptions = Algorithms::Deadline::interruptions();
+
+    for (int i = 0; i < std::min(workers, (int)jobs.size()); i++)
+        threads.push_back(std::thread(&Batch::work, this, std::ref(output)));
+
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    summarize(output);
+    return !interrupted();
+}
+
+//------------------------------------------------------------------------------
+// Worker thread
+
+void Batch::work(std::ostream &output)
+{
+    while (true) {
+        size_t index;
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (next >= jobs.size() || interrupted())
+                return;
+
+            index = next++;
+        }
+
+        const std::string line = execute(jobs[index]);
+
+        if (line.empty())
+            return;
+
+        std::lock_guard<std::mutex> guard(lock);
+        output << line << std::endl;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Load the file of a source, once for all its jobs
+
+void Batch::open(Source &source, const std::string &path)
+{
+    std::shared_ptr<Problem> problem = std::make_shared<Problem>();
+
+    // Other workers load their own files meanwhile
+
+    if (!problem->load(path.c_str(), layout, order))
+        return;
+
+    std::lock_guard<std::mutex> guard(lock);
+    source.problem = problem;
+}
+
+//------------------------------------------------------------------------------
+// Run a job and compose its line
+
+std::string Batch::execute(Job &job)
+{
+    const Request &request = job.request;
+    std::shared_ptr<Problem> problem;
+    std::ostringstream line;
+
+    if (job.source) {
+        Source &source = *job.source;
+
+        std::call_once(source.loaded, &Batch::open, this, std::ref(source), std::cref(request.path));
+
+        std::lock_guard<std::mutex> guard(lock);
+        problem = source.problem;
+
+        // The last job of a file releases it
+
+        if (--source.pending == 0)
+            source.problem.reset();
+    } else {
+        problem = std::make_shared<Problem>();
+
+        if (!problem->load(request.points, layout, order))
+            problem.reset();
+    }
+
+    if (!problem)
+        return "error," + request.id + ",could not load the problem";
+
+    // Loading takes a while, and the search would miss an earlier interruption
+
+    if (interrupted())
+        return "";
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const double cpu = threadTime();
+    const Result result = problem->solve(request.settings, results);
+    const long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (!result.solved)
+        return "error," + request.id + ",the search failed";
+
+    if (!request.tour.empty()) {
+        Cycle tour(problem->getCycle());
+
+        if (!tour.setTour(result.tour.data(), (int)result.tour.size()) || !tour.saveTour(request.tour.c_str()))
+            return "error," + request.id + ",could not write " + request.tour;
+    }
+
+    job.done = true;
+    job.cost = result.cost;
+
+    line << "job," << request.id << "," << (request.path.empty() ? "points" : request.path) << "," << job.settings
+         << "," << request.settings.seed << "," << result.cost << "," << elapsed << "," << (long)(threadTime() - cpu)
+         << "," << result.steps << "," << (result.cached ? 1 : 0) << "," << request.tour;
+
+    return line.str();
+}
+
+//------------------------------------------------------------------------------
+// Write the summary of each group
+
+void Batch::summarize(std::ostream &output) const
+{
+    output << "# summary,tsp,settings,runs,mean,stddev,best,best_id" << std::endl;
+
+    for (size_t g = 0; g < groups.size(); g++) {
+        double sum = 0, squares = 0;
+        const Job *best = NULL;
+        int runs = 0;
+
+        for (size_t i = 0; i < jobs.size(); i++) {
+            if (jobs[i].group != g || !jobs[i].done)
+                continue;
+
+            runs++;
+            sum += jobs[i].cost;
+
+            if (best == NULL || jobs[i].cost < best->cost)
+                best = &jobs[i];
+        }
+
+        if (runs == 0)
+            continue;
+
+        const double mean = sum / runs;
+
+        for (size_t i = 0; i < jobs.size(); i++)
+            if (jobs[i].group == g && jobs[i].done)
+                squares += (jobs[i].cost - mean) * (jobs[i].cost - mean);
+
+        output << "summary," << groups[g].path << "," << groups[g].settings << "," << runs << "," << mean << ","
+               << (runs > 1 ? sqrt(squares / (runs - 1)) : 0.0) << "," << best->cost << "," << best->request.id << std::endl;
+    }
+}
+
+}
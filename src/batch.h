@@ -0,0 +1,132 @@
+/**
+ * @file batch.h
+ * @brief Declaration of the Batch class
+ * @date October 19, 2026
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include "daemon.h"
+
+namespace Tsp
+{
+
+/**
+ * @brief Batch Class
+ *
+ * Runs a manifest of solve jobs in one process, on a pool of worker threads.
+ * Each TSP file is loaded once, when its first job starts, and dropped after
+ * its last job, so every job on the same file shares the distance matrix and
+ * the candidate lists.
+ *
+ * The manifest holds one job per line: either the fields of a daemon request
+ * (without the "solve" command), or CSV rows under a header line that names
+ * the fields. Blank lines and lines starting with '#' are skipped.
+ *
+ *     id=1 tsp=data/kroA100.tsp algorithm=ga crossover=eax seed=1 out=1.tour
+ *
+ *     id,tsp,algorithm,crossover,seed
+ *     1,data/kroA100.tsp,ga,eax,1
+ *
+ * A line is written as soon as each job is done, and after the last one,
+ * a summary of every file and setting over the seeds (CSV):
+ *
+ *     job,ID,TSP,SETTINGS,SEED,COST,WALL_MS,CPU_MS,STEPS,CACHED,TOUR
+ *     error,ID,MESSAGE
+ *     summary,TSP,SETTINGS,RUNS,MEAN,STDDEV,BEST,BEST_ID
+ *
+ * SETTINGS are the fields of the job but id, tsp, seed and out. CPU time is
+ * that of the worker thread, so it leaves out the threads of psa and pga.
+ */
+class Batch
+{
+public:
+
+    /**
+     * @brief Constructor
+     * @param workers Number of worker threads.
+     * @param layout Storage layout of the loaded problems.
+     * @param order Internal numbering of the loaded problems.
+     * @param results Cache of results (NULL for none), which must outlive the
+     *        batch.
+     */
+    Batch(int workers, Instance::Layout layout = Instance::Packed, Instance::Order order = Instance::Original, ResultCache *results = NULL);
+
+    /**
+     * @brief Read a manifest
+     * @param path File path ("-" for the standard input).
+     * @return Whether every job was valid (the first error is printed).
+     */
+    bool load(const char *path);
+
+    /**
+     * @brief Run the jobs
+     * @param output Destination of the result lines.
+     *
+     * After an interruption (see Algorithms::Deadline::interrupt()), the jobs
+     * in progress keep their best tour, and the rest are skipped.
+     *
+     * @return Whether every job was run.
+     */
+    bool run(std::ostream &output);
+
+private:
+
+    /// TSP file shared by several jobs
+    struct Source {
+        std::once_flag loaded;          ///< Guards the loading
+        std::shared_ptr<Problem> problem;   ///< NULL once its jobs are done
+        int pending;                    ///< Jobs not done yet
+    };
+
+    /// Job of the manifest
+    struct Job {
+        Request request;                ///< Problem, settings and destination
+        std::string settings;           ///< Fields that define the search
+        std::shared_ptr<Source> source; ///< NULL if the points are given
+        size_t group;                   ///< Index of the summary
+        bool done;                      ///< Whether it has a result
+        float cost;                     ///< Length of the tour
+    };
+
+    /// Runs of a file with the same settings
+    struct Group {
+        std::string path;
+        std::string settings;
+    };
+
+    int workers;
+    Instance::Layout layout;
+    Instance::Order order;
+    ResultCache *results;
+    std::vector<Job> jobs;
+    std::vector<Group> groups;
+    std::map<std::string, size_t> groupIndex;
+    std::map<std::string, std::shared_ptr<Source> > sources;
+    size_t next;                        ///< Next job to run
+    unsigned long interruptions;        ///< Interruptions before the run
+    std::mutex lock;                    ///< Guards next, output and sources
+
+    bool add(const std::string &fields, int line);
+    void work(std::ostream &output);
+    void open(Source &source, const std::string &path);
+    std::string execute(Job &job);
+    void summarize(std::ostream &output) const;
+
+    /// Whether the run was interrupted
+    inline bool interrupted() const
+    {
+        return Algorithms::Deadline::interruptions() != interruptions;
+    }
+};
+
+}
+
+#endif /* BATCH_H */
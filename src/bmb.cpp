@@ -6,20 +6,23 @@
 namespace Algorithms
 {
 
-void basicMultibootSearch(Cycle &data, int count, unsigned int seed)
+void basicMultibootSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline)
 {
     Cycle &bestCycle = data;
     Cycle curCycle = data;
-    std::mt19937 generator(seed);
+    Generator generator(seed);
 
     bestCycle.clearPath();
 
     for (int k = 0; k < count; k++) {
         curCycle.shufflePath(generator);
-        localSearch(data);
+        localSearch(data, deadline);
 
         if (curCycle.getCost() < bestCycle.getCost())
             bestCycle.setPath(curCycle);
+
+        if (deadline.expired())
+            break;
     }
 }
 
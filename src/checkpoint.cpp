@@ -0,0 +1,467 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Definition of the Checkpoint class
+ * @date October 19, 2026
+ */
+
+#include "checkpoint.h"
+#include <iostream>
+#include <cstring>
+#include <cfloat>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "cycle.h"
+
+/// Header of a checkpoint file
+struct CheckpointHeader {
+    char magic[8];          ///< CHECKPOINT_MAGIC
+    uint32_t version;       ///< CHECKPOINT_VERSION
+    uint32_t algorithm;     ///< Algorithm of the search
+    uint64_t hash;          ///< Content hash of the instance
+    uint64_t numbering;     ///< Hash of the original numbers of the nodes
+    int32_t nodes;          ///< Number of nodes
+    int32_t count;          ///< Repetitions or generations
+    int32_t size;           ///< Width of the population
+    int32_t processes;      ///< Number of islands or replicas
+    int32_t migrLatency;    ///< Generations between migrations
+    uint32_t seed;          ///< Seed of the random streams
+    uint32_t neighbor;      ///< Neighbor generator of annealing
+    uint32_t scheme;        ///< Evolutionary scheme of the GA
+    uint32_t hybridization; ///< Hybridization of the memetic algorithm
+    uint32_t topology;      ///< Migration topology of the parallel GA
+    uint32_t crossover;     ///< Crossover operator
+    uint32_t warmStart;     ///< Whether a starting tour follows the header
+    uint64_t length;        ///< Bytes of state after the header
+    uint64_t checksum;      ///< FNV-1a hash of the state
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Add bytes to a 64-bit FNV-1a hash
+ * @param hash Current value of the hash.
+ * @param data Bytes to add.
+ * @param length Number of bytes.
+ * @return New value of the hash.
+ */
+static uint64_t fnv(uint64_t hash, const void *data, size_t length)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Hash of the numbering of the nodes
+ * @param data Cycle with the instance loaded.
+ *
+ * Tours are saved with the numbers used in memory, which depend on the order
+ * the instance was loaded with (or compiled with).
+ *
+ * @return Hash of the original number of each node.
+ */
+static uint64_t numbering(const Cycle &data)
+{
+    const Instance &instance = *data.getInstance();
+    uint64_t result = 0xcbf29ce484222325ULL;
+
+    for (int i = 0; i < data.getSize(); i++) {
+        const int32_t id = instance.idOf(i);
+        result = fnv(result, &id, sizeof(id));
+    }
+
+    return result;
+}
+
+namespace Algorithms
+{
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Checkpoint::Checkpoint(const char *path, long interval, const Settings &settings) : settings(settings)
+{
+    this->path = path;
+    this->interval = std::chrono::milliseconds(interval);
+    last = Clock::now();
+    cursor = 0;
+    resuming = false;
+    startCost = FLT_MAX;
+    ready = false;
+    stopping = false;
+    writer = std::thread(&Checkpoint::work, this);
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+
+Checkpoint::~Checkpoint()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+
+    wake.notify_one();
+    writer.join();
+}
+
+//------------------------------------------------------------------------------
+// Load a checkpoint to resume
+
+bool Checkpoint::load(const char *path, const Cycle &data)
+{
+    using namespace std;
+    struct stat status;
+    CheckpointHeader header;
+    vector<char> file;
+    size_t done = 0;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &status) < 0) {
+        cerr << "Could not open checkpoint " << path << endl;
+
+        if (fd >= 0)
+            close(fd);
+
+        return false;
+    }
+
+    file.resize(status.st_size);
+
+    while (done < file.size()) {
+        const ssize_t count = read(fd, &file[done], file.size() - done);
+
+        if (count < 0 && errno == EINTR)
+            continue;
+        else if (count <= 0)
+            break;
+
+        done += count;
+    }
+
+    close(fd);
+
+    if (done < sizeof(header) || done != file.size()) {
+        cerr << "Read error: checkpoint " << path << " is truncated.\n";
+        return false;
+    }
+
+    memcpy(&header, &file[0], sizeof(header));
+
+    if (memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) || header.version != CHECKPOINT_VERSION) {
+        cerr << "Read error: " << path << " is not a checkpoint of this version.\n";
+        return false;
+    }
+
+    if (header.length != file.size() - sizeof(header) || header.checksum != fnv(0xcbf29ce484222325ULL, &file[sizeof(header)], header.length)) {
+        cerr << "Read error: checkpoint " << path << " is corrupt.\n";
+        return false;
+    }
+
+    if (header.nodes != data.getSize() || header.hash != data.getInstance()->getHash() || header.numbering != numbering(data)) {
+        cerr << "Checkpoint " << path << " belongs to another instance (or another --order).\n";
+        return false;
+    }
+
+    if (!supports((Algorithm)header.algorithm)) {
+        cerr << "Read error: checkpoint " << path << " has no supported algorithm.\n";
+        return false;
+    }
+
+    const long timeLimit = settings.timeLimit;
+    settings = Settings((Algorithm)header.algorithm, header.seed);
+    settings.count = header.count;
+    settings.size = header.size;
+    settings.processes = header.processes;
+    settings.migrLatency = header.migrLatency;
+    settings.neighbor = (NeighborGenerator)header.neighbor;
+    settings.scheme = (Scheme)header.scheme;
+    settings.hybridization = (Hybridization)header.hybridization;
+    settings.topology = (Topology)header.topology;
+    settings.crossover = (Crossover)header.crossover;
+    settings.warmStart = header.warmStart != 0;
+    settings.timeLimit = timeLimit;
+
+    loaded.assign(file.begin() + sizeof(header), file.end());
+    cursor = 0;
+    start.clear();
+
+    // The starting tour comes before the state of the algorithm
+
+    if (settings.warmStart) {
+        int32_t size;
+
+        get(size);
+        get(startCost);
+
+        if (size != header.nodes || cursor + sizeof(int) * size > loaded.size()) {
+            cerr << "Read error: checkpoint " << path << " is corrupt.\n";
+            return false;
+        }
+
+        start.assign((const int *)&loaded[cursor], (const int *)&loaded[cursor] + size);
+        loaded.erase(loaded.begin(), loaded.begin() + cursor + sizeof(int) * size);
+        cursor = 0;
+    }
+
+    resuming = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Keep the starting tour
+
+void Checkpoint::setStart(const Cycle &tour)
+{
+    start.assign(&tour.edgeAt(0), &tour.edgeAt(0) + tour.getSize());
+    startCost = tour.getCost();
+}
+
+//------------------------------------------------------------------------------
+// Get the starting tour of the loaded search
+
+bool Checkpoint::getStart(Cycle &tour) const
+{
+    if (start.empty() || (int)start.size() != tour.getSize())
+        return false;
+
+    tour.setPath(start.data(), startCost);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Check the algorithm
+
+bool Checkpoint::supports(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case SA:
+    case Genetic:
+    case Memetic:
+    case ParallelSA:
+    case ParallelGenetic:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Start reading the loaded state
+
+bool Checkpoint::restore()
+{
+    if (!resuming)
+        return false;
+
+    resuming = false;
+    cursor = 0;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Check the interval
+
+bool Checkpoint::due() const
+{
+    return Clock::now() - last >= interval;
+}
+
+//------------------------------------------------------------------------------
+// Start a new state
+
+void Checkpoint::begin(const Cycle &data)
+{
+    CheckpointHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.algorithm = settings.algorithm;
+    header.hash = data.getInstance()->getHash();
+    header.numbering = numbering(data);
+    header.nodes = data.getSize();
+    header.count = settings.count;
+    header.size = settings.size;
+    header.processes = settings.processes;
+    header.migrLatency = settings.migrLatency;
+    header.seed = settings.seed;
+    header.neighbor = settings.neighbor;
+    header.scheme = settings.scheme;
+    header.hybridization = settings.hybridization;
+    header.topology = settings.topology;
+    header.crossover = settings.crossover;
+    header.warmStart = !start.empty();
+
+    buffer.clear();
+    put(&header, sizeof(header));
+
+    if (!start.empty()) {
+        put((int32_t)start.size());
+        put(startCost);
+        put(start.data(), sizeof(int) * start.size());
+    }
+}
+
+//------------------------------------------------------------------------------
+// Add bytes to the state
+
+void Checkpoint::put(const void *bytes, size_t length)
+{
+    buffer.insert(buffer.end(), (const char *)bytes, (const char *)bytes + length);
+}
+
+//------------------------------------------------------------------------------
+// Add a tour and its cost to the state
+
+void Checkpoint::put(const Cycle &cycle)
+{
+    const int32_t size = cycle.getSize();
+    const float cost = cycle.getCost();
+
+    put(size);
+    put(cost);
+    put(&cycle.edgeAt(0), sizeof(int) * size);
+}
+
+//------------------------------------------------------------------------------
+// Hand the state to the writer thread
+
+void Checkpoint::commit()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queued.swap(buffer);
+        ready = true;
+    }
+
+    wake.notify_one();
+    last = Clock::now();
+}
+
+//------------------------------------------------------------------------------
+// Read bytes of the loaded state
+
+void Checkpoint::get(void *bytes, size_t length)
+{
+    if (cursor + length > loaded.size()) {
+        memset(bytes, 0, length);
+        cursor = loaded.size();
+        return;
+    }
+
+    memcpy(bytes, &loaded[cursor], length);
+    cursor += length;
+}
+
+//------------------------------------------------------------------------------
+// Read a tour and its cost
+
+void Checkpoint::get(Cycle &cycle)
+{
+    int32_t size;
+    float cost;
+
+    get(size);
+    get(cost);
+
+    if (size != cycle.getSize() || cursor + sizeof(int) * size > loaded.size()) {
+        cursor = loaded.size();
+        return;
+    }
+
+    cycle.setPath((const int *)&loaded[cursor], cost);
+    cursor += sizeof(int) * size;
+}
+
+//------------------------------------------------------------------------------
+// Writer thread
+
+void Checkpoint::work()
+{
+    std::vector<char> state;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            while (!ready && !stopping)
+                wake.wait(guard);
+
+            if (!ready)
+                return;
+
+            state.swap(queued);
+            ready = false;
+        }
+
+        write(state);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Write a state to a temporary file and rename it over the checkpoint
+
+bool Checkpoint::write(std::vector<char> &state)
+{
+    using namespace std;
+    CheckpointHeader header;
+    const string temporary = path + ".tmp";
+    size_t done = 0;
+    int fd;
+
+    // The checksum is left to this thread, not to the search
+
+    memcpy(&header, &state[0], sizeof(header));
+    header.length = state.size() - sizeof(header);
+    header.checksum = fnv(0xcbf29ce484222325ULL, &state[sizeof(header)], header.length);
+    memcpy(&state[0], &header, sizeof(header));
+
+    fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        cerr << "Could not write checkpoint " << temporary << ": " << strerror(errno) << endl;
+        return false;
+    }
+
+    while (done < state.size()) {
+        const ssize_t count = ::write(fd, &state[done], state.size() - done);
+
+        if (count < 0 && errno == EINTR)
+            continue;
+        else if (count <= 0)
+            break;
+
+        done += count;
+    }
+
+    if (done < state.size() || fsync(fd) < 0) {
+        cerr << "Could not write checkpoint " << temporary << ": " << strerror(errno) << endl;
+        close(fd);
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    close(fd);
+
+    if (rename(temporary.c_str(), path.c_str()) < 0) {
+        cerr << "Could not write checkpoint " << path << ": " << strerror(errno) << endl;
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+}
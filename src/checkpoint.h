@@ -0,0 +1,172 @@
+/**
+ * @file checkpoint.h
+ * @brief Declaration of the Checkpoint class
+ * @date October 19, 2026
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "solver.h"
+
+#define CHECKPOINT_MAGIC "TSPCKPT\n"    ///< First bytes of a checkpoint file
+#define CHECKPOINT_VERSION 1            ///< Version of the checkpoint format
+
+namespace Algorithms
+{
+
+/**
+ * @brief Saved state of a search, to resume it later
+ *
+ * Long searches (sa, ga, ma, psa and pga) save their whole state every few
+ * seconds and when they stop: tours with their exact costs, random streams,
+ * counters, the annealing temperature. Resuming from that state gives the
+ * same result as a search that was never stopped.
+ *
+ * The search thread only copies its state into a buffer, between two steps of
+ * its main loop. A background thread writes the buffer to a temporary file
+ * and renames it over the checkpoint, so that the file is always complete.
+ * If a write is still running when the next state comes, the older pending
+ * state is dropped.
+ *
+ * The file holds a header (the settings of the search and the hash of the
+ * instance), the starting tour of a warm-started search, and the state, as
+ * the algorithm wrote it with put(). Resuming reads it back in the same order
+ * with get(), and the starting tour is still kept if the search ends worse.
+ */
+class Checkpoint
+{
+public:
+
+    /**
+     * @brief Constructor
+     * @param path Destination of the checkpoints.
+     * @param interval Milliseconds between two checkpoints.
+     * @param settings Settings of the search.
+     */
+    Checkpoint(const char *path, long interval, const Settings &settings);
+
+    /// Destructor: waits for the last write
+    ~Checkpoint();
+
+    /**
+     * @brief Load a checkpoint to resume
+     * @param path File to read.
+     * @param data Cycle with the instance loaded.
+     *
+     * The settings of the checkpoint replace the current ones, but the time
+     * limit. The instance must be the same, with the same numbering.
+     *
+     * @return Whether the file is a valid checkpoint of the instance.
+     */
+    bool load(const char *path, const Cycle &data);
+
+    /// Settings of the search (those of the loaded checkpoint, if any)
+    inline const Settings & getSettings() const
+    {
+        return settings;
+    }
+
+    /**
+     * @brief Keep the tour a warm-started search starts from
+     * @param tour Starting tour, saved in every checkpoint.
+     */
+    void setStart(const Cycle &tour);
+
+    /**
+     * @brief Get the tour the loaded search started from
+     * @param tour Destination, unchanged if the search was not warm-started.
+     * @return Whether the loaded checkpoint has a starting tour.
+     */
+    bool getStart(Cycle &tour) const;
+
+    /**
+     * @brief Check the algorithm
+     * @param algorithm Algorithm to run.
+     * @return Whether @p algorithm saves checkpoints.
+     */
+    static bool supports(Algorithm algorithm);
+
+    /**
+     * @brief Start reading the loaded state
+     * @return Whether there is a loaded state left to resume (only once).
+     */
+    bool restore();
+
+    /**
+     * @brief Check the interval
+     * @return Whether it is time to save a checkpoint.
+     */
+    bool due() const;
+
+    /**
+     * @brief Start a new state
+     * @param data Cycle with the instance loaded.
+     */
+    void begin(const Cycle &data);
+
+    /// Add bytes to the state
+    void put(const void *bytes, size_t length);
+
+    /// Add a tour and its cost to the state
+    void put(const Cycle &cycle);
+
+    /// Add a value to the state
+    template <class T>
+    inline void put(const T &value)
+    {
+        put(&value, sizeof(T));
+    }
+
+    /// Hand the state to the writer thread
+    void commit();
+
+    /// Read bytes of the loaded state
+    void get(void *bytes, size_t length);
+
+    /// Read a tour and its cost (exactly as they were saved)
+    void get(Cycle &cycle);
+
+    /// Read a value of the loaded state
+    template <class T>
+    inline void get(T &value)
+    {
+        get(&value, sizeof(T));
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    std::string path;           ///< Destination of the checkpoints
+    Clock::duration interval;   ///< Time between two checkpoints
+    Clock::time_point last;     ///< Time of the last checkpoint
+    Settings settings;          ///< Settings of the search
+    std::vector<char> loaded;   ///< State to resume
+    size_t cursor;              ///< Next byte of the loaded state
+    bool resuming;              ///< Whether the loaded state was not read yet
+    std::vector<int> start;     ///< Tour of a warm start (empty for none)
+    float startCost;            ///< Cost of the starting tour
+    std::vector<char> buffer;   ///< State being built by the search thread
+    std::vector<char> queued;   ///< State waiting for the writer
+    bool ready;                 ///< Whether there is a state queued
+    bool stopping;              ///< Whether the writer must finish
+    std::mutex lock;            ///< Guard of queued, ready and stopping
+    std::condition_variable wake;   ///< Signal to the writer
+    std::thread writer;         ///< Writer thread
+
+    Checkpoint(const Checkpoint &);
+    Checkpoint & operator=(const Checkpoint &);
+
+    void work();
+    bool write(std::vector<char> &state);
+};
+
+}
+
+#endif /* CHECKPOINT_H */
@@ -5,113 +5,13 @@
  */
 
 #include <iostream>
-#include <fstream>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
-#include <cmath>
-#include <random>
+#include <vector>
 #include "cycle.h"
 #include "algorithms.h"
-
-#define LINE_WIDTH 80   /// Maximum length for one line
-
-//------------------------------------------------------------------------------
-
-/**
- * @brief Get the value of a tag in a file
- * @param file Data stream.
- * @param result String where the result will be stored.
- * @param label Label to be searched.
- *
- * A label (word before ':') is searched for and the rest of the line is written
- * to the result string. The search starts at the beginning of the file, and the
- * pointer stays at the beginning of the next line.
- *
- * @return Whether the tag was found.
- */
-static bool fileTag(std::ifstream &file, char *result, const char *label)
-{
-    using namespace std;
-
-    char _str[LINE_WIDTH];
-    size_t length = strlen(label);
-
-    file.seekg(0, ios_base::beg);
-
-    do {
-        file.getline(_str, LINE_WIDTH, ':');
-        _str[length] = '\0';
-
-        if (strcmp(_str, label))
-            file.ignore(LINE_WIDTH, '\n');
-        else {
-            file.getline(result, LINE_WIDTH);
-            return true;
-        }
-    } while (!file.fail());
-
-    cerr << "Reading error: label <" << label << "> not found.\n";
-    return false;
-}
-
-//------------------------------------------------------------------------------
-
-/**
- * @brief Check an attribute in a file
- * @param file Data flow.
- * @param attrib Name of the attribute (tag).
- * @param value Value that the attribute is expected to have.
- * @return Whether the tag was found and the value matches.
- */
-static bool fileAssert(std::ifstream &file, const char *attrib, const char *value)
-{
-    char _str[LINE_WIDTH];
-    char *_ptr = _str;
-
-    if (!fileTag(file, _str, attrib))
-        return false;
-
-    while (*_ptr == ' ')
-        _ptr++;
-
-    file.unget();
-
-    if (strcmp(_ptr, value)) {
-        std::cerr << "Read error: Expected <" << attrib << "=="
-                  << value << "> and got <" << _str << ">\n";
-        return false;
-    }
-
-    return true;
-}
-
-//------------------------------------------------------------------------------
-
-/**
- * @brief Find a line within a file
- * @param file Data flow.
- * @param line Line to search for.
- * @post The pointer is placed at the beginning of the next line.
- * @return whether the line was found.
- */
-static bool fileFindLine(std::ifstream &file, const char *line)
-{
-    using namespace std;
-    char _str[LINE_WIDTH];
-
-    file.seekg(0, ios_base::beg);
-
-    do {
-        file.getline(_str, LINE_WIDTH);
-
-        if (!strcmp(_str, line))
-            return true;
-    } while (!file.fail());
-
-    cerr << "Error de lectura: texto <" << line << "> no encontrado.\n";
-    return false;
-}
+#include "allocator.h"
 
 //------------------------------------------------------------------------------
 // Default constructor
@@ -119,10 +19,12 @@ static bool fileFindLine(std::ifstream &file, const char *line)
 Cycle::Cycle()
 {
     size = 0;
-    cost = FLT_MAX;
-    vertices = NULL;
+    ownCost = FLT_MAX;
+    cost = &ownCost;
     edges = NULL;
-    distances = NULL;
+    view = false;
+    pathHash = 0;
+    hashed = false;
 }
 
 //------------------------------------------------------------------------------
@@ -130,11 +32,14 @@ Cycle::Cycle()
 
 Cycle::Cycle(int size)
 {
+    this->instance = std::make_shared<Instance>(size);
     this->size = size;
-    this->cost = FLT_MAX;
-    this->vertices = (Vertex*)calloc(sizeof(Vertex), size);
-    this->edges = (int*)calloc(sizeof(int), size);
-    this->distances = (float*)calloc(sizeof(float), size * size);
+    this->ownCost = FLT_MAX;
+    this->cost = &ownCost;
+    this->edges = Allocator::allocate<int>(size, true);
+    this->view = false;
+    this->pathHash = 0;
+    this->hashed = false;
 }
 
 //------------------------------------------------------------------------------
@@ -143,13 +48,14 @@ Cycle::Cycle(int size)
 Cycle::Cycle(const char *path)
 {
     size = 0;
-    cost = FLT_MAX;
-    vertices = NULL;
+    ownCost = FLT_MAX;
+    cost = &ownCost;
     edges = NULL;
-    distances = NULL;
+    view = false;
+    pathHash = 0;
+    hashed = false;
 
-    if (!loadTsp(path))
-        exit(EXIT_FAILURE);
+    loadTsp(path);
 }
 
 //------------------------------------------------------------------------------
@@ -157,19 +63,31 @@ Cycle::Cycle(const char *path)
 
 Cycle::Cycle(const Cycle &other)
 {
-    size_t sVertices = sizeof(Vertex) * other.size;
-    size_t sEdges = sizeof(int) * other.size;
-    size_t sDistances = sizeof(float) * other.size * other.size;
-
+    instance = other.instance;
     size = other.size;
-    cost = other.cost;
-    vertices = (Vertex*)malloc(sVertices);
-    edges = (int*)malloc(sEdges);
-    distances = (float*)malloc(sDistances);
-
-    memcpy(vertices, other.vertices, sVertices);
-    memcpy(edges, other.edges, sEdges);
-    memcpy(distances, other.distances, sDistances);
+    ownCost = *other.cost;
+    cost = &ownCost;
+    edges = Allocator::allocate<int>(other.size);
+    view = false;
+    pathHash = other.pathHash;
+    hashed = other.hashed;
+
+    memcpy(edges, other.edges, sizeof(int) * other.size);
+}
+
+//------------------------------------------------------------------------------
+// View constructor
+
+Cycle::Cycle(const Cycle &sample, int *edges, float *cost)
+{
+    this->instance = sample.instance;
+    this->size = sample.size;
+    this->ownCost = FLT_MAX;
+    this->cost = cost;
+    this->edges = edges;
+    this->view = true;
+    this->pathHash = 0;
+    this->hashed = false;
 }
 
 //------------------------------------------------------------------------------
@@ -177,9 +95,8 @@ Cycle::Cycle(const Cycle &other)
 
 Cycle::~Cycle()
 {
-    free(vertices);
-    free(edges);
-    free(distances);
+    if (!view)
+        Allocator::release(edges);
 }
 
 //------------------------------------------------------------------------------
@@ -187,29 +104,20 @@ Cycle::~Cycle()
 
 Cycle & Cycle::operator=(const Cycle &other)
 {
-    size_t sVertices = sizeof(Vertex) * other.size;
-    size_t sEdges = sizeof(int) * other.size;
-    size_t sDistances = sizeof(float) * other.size * other.size;
-
-    if (size == 0) {
-        vertices = (Vertex*)malloc(sVertices);
-        edges = (int*)malloc(sEdges);
-        distances = (float*)malloc(sDistances);
-    }
+    if (this == &other)
+        return *this;
 
-    // We expand the vectors if necessary (but never shrink)
+    // We expand the path if necessary (but never shrink)
 
-    if (size < other.size) {
-        vertices = (Vertex*)realloc(vertices, sVertices);
-        edges = (int*)realloc(edges, sEdges);
-        distances = (float*)realloc(distances, sDistances);
-    }
+    if (!view)
+        edges = Allocator::reallocate(edges, other.size);
 
+    instance = other.instance;
     size = other.size;
-    cost = other.cost;
-    memcpy(vertices, other.vertices, sVertices);
-    memcpy(edges, other.edges, sEdges);
-    memcpy(distances, other.distances, sDistances);
+    *cost = *other.cost;
+    memcpy(edges, other.edges, sizeof(int) * size);
+    pathHash = other.pathHash;
+    hashed = other.hashed;
 
     return *this;
 }
@@ -217,163 +125,289 @@ Cycle & Cycle::operator=(const Cycle &other)
 //------------------------------------------------------------------------------
 // Load nodes from a TSP file
 
-bool Cycle::loadTsp(const char *path)
+bool Cycle::loadTsp(const char *path, Layout layout, Order order)
 {
-    using namespace std;
-    int newSize;
-    char _str[LINE_WIDTH];
-    ifstream file(path);
+    std::shared_ptr<Instance> newInstance = std::make_shared<Instance>();
 
-    if (!file) {
-        cerr << "Could not open file " << path << endl;
+    if (view || !newInstance->loadTsp(path, layout, order))
         return false;
-    }
 
-    // Cabecera
+    instance = newInstance;
+    size = instance->getSize();
+    edges = Allocator::reallocate(edges, size);
+    clearPath();
 
-    if (!fileAssert(file, "TYPE", "TSP"))
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Map a raw distance matrix
+
+bool Cycle::loadMatrix(const char *path, Instance::Weight weight)
+{
+    std::shared_ptr<Instance> newInstance = std::make_shared<Instance>();
+
+    if (view || !newInstance->loadMatrix(path, weight))
         return false;
 
-    if (!fileTag(file, _str, "DIMENSION"))
+    instance = newInstance;
+    size = instance->getSize();
+    edges = Allocator::reallocate(edges, size);
+    clearPath();
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Load nodes from memory
+
+bool Cycle::loadVertices(const Vertex *vertices, int size, Layout layout, Order order)
+{
+    std::shared_ptr<Instance> newInstance = std::make_shared<Instance>();
+
+    if (view || !newInstance->loadVertices(vertices, size, layout, order))
         return false;
 
-    newSize = atoi(_str);
+    instance = newInstance;
+    this->size = instance->getSize();
+    edges = Allocator::reallocate(edges, this->size);
+    clearPath();
 
-    if (newSize == 0) {
-        cerr << "Read error: dimension not recognized.\n";
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Load path from a TOUR file
+
+bool Cycle::loadTour(const char *path)
+{
+    if (!instance || !instance->loadTour(path, edges))
         return false;
-    }
 
-    if (newSize > size) {
-        vertices = (Vertex*)realloc(vertices, sizeof(Vertex) * newSize);
-        edges = (int*)realloc(edges, sizeof(int) * newSize);
-        distances = (float*)realloc(distances, sizeof(float) * newSize * newSize);
-    }
+    updateCost();
+    return true;
+}
 
-    size = newSize;
+//------------------------------------------------------------------------------
+// Save route to a TOUR file
+
+bool Cycle::saveTour(const char *path) const
+{
+    return instance->saveTour(path, edges);
+}
 
-    if (!fileAssert(file, "EDGE_WEIGHT_TYPE", "EUC_2D"))
+//------------------------------------------------------------------------------
+// Set path
+
+bool Cycle::setPath(const Cycle &other)
+{
+    if (other.size != size)
         return false;
 
-    // Leer vértices
+    memcpy(edges, other.edges, sizeof(int) * size);
+    *cost = *other.cost;
+    pathHash = other.pathHash;
+    hashed = other.hashed;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Set a saved path
+
+void Cycle::setPath(const int *edges, float cost)
+{
+    memcpy(this->edges, edges, sizeof(int) * size);
+    *this->cost = cost;
+    hashed = false;
+}
+
+//------------------------------------------------------------------------------
+// Set path from original node numbers
 
-    if (!fileFindLine(file, "NODE_COORD_SECTION"))
+bool Cycle::setTour(const int *ids, int count)
+{
+    if (!instance || count != size)
         return false;
 
+    std::vector<int> indexes(size, -1);
+    std::vector<int> path(size);
+
+    for (int i = 0; i < size; i++)
+        indexes[instance->idOf(i)] = i;
+
+    // Each index is taken once, so a repeated number fails
+
     for (int i = 0; i < size; i++) {
-        file.ignore(LINE_WIDTH, ' ');
-        file >> vertices[i].x >> vertices[i].y;
-        file.ignore(LINE_WIDTH, '\n');
-    }
+        if (ids[i] < 0 || ids[i] >= size || indexes[ids[i]] < 0)
+            return false;
 
-    cost = FLT_MAX;
-    memset(edges, 0, sizeof(int) * size);
-    file.close();
-    updateDistances();
+        path[i] = indexes[ids[i]];
+        indexes[ids[i]] = -1;
+    }
 
+    memcpy(edges, path.data(), sizeof(int) * size);
+    hashed = false;
+    updateCost();
     return true;
 }
 
 //------------------------------------------------------------------------------
-// Load path from a TOUR file
+// Add a node and insert it in the path
 
-bool Cycle::loadTour(const char *path)
+bool Cycle::insertVertex(const Vertex &vertex)
 {
-    using namespace std;
-    int _size;
-    char _str[LINE_WIDTH];
-    ifstream file(path);
+    Instance *editable = exclusive();
 
-    if (!file) {
-        cerr << "No se pudo abrir el archivo " << path << endl;
+    if (editable == NULL || editable->addVertex(vertex) < 0)
         return false;
-    }
 
-    // Head
+    edges = Allocator::reallocate(edges, size + 1);
+    insertNode(size);
+    return true;
+}
 
-    if (!fileAssert(file, "TYPE", "TOUR"))
-        return false;
+//------------------------------------------------------------------------------
+// Remove a node from the instance and from the path
+
+bool Cycle::removeVertex(int node)
+{
+    Instance *editable = exclusive();
+    int position = 0;
 
-    if (!fileTag(file, _str, "DIMENSION"))
+    if (editable == NULL || node < 0 || node >= size || size == 1)
         return false;
 
-    _size = atoi(_str);
+    while (edges[position] != node)
+        position++;
 
-    if (_size != size) {
-        cerr << "Reading error: the path dimension is incorrect.\n";
-        file.close();
-        return false;
-    }
+    // The cost is taken while the distances of the node still exist
 
-    // Read edges
+    const float change = removalCost(position);
 
-    if (!fileFindLine(file, "TOUR_SECTION"))
+    if (!editable->removeVertex(node))
         return false;
 
+    memmove(edges + position, edges + position + 1, sizeof(int) * (size - position - 1));
+    size--;
+    *cost += change;
+    hashed = false;
+
     for (int i = 0; i < size; i++) {
-        file >> edges[i];
-        edges[i]--;
+        if (edges[i] == size) {
+            edges[i] = node;
+            break;
+        }
     }
 
-    if (!file) {
-        cerr << "Error de lectura: faltan nodos.\n";
-        file.close();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Move a node and insert it again in the path
+
+bool Cycle::moveVertex(int node, const Vertex &vertex)
+{
+    Instance *editable = exclusive();
+    int position = 0;
+
+    if (editable == NULL || node < 0 || node >= size)
         return false;
-    }
 
-    file.close();
-    updateCost();
+    while (edges[position] != node)
+        position++;
+
+    const float change = removalCost(position);
+
+    if (!editable->moveVertex(node, vertex))
+        return false;
+
+    memmove(edges + position, edges + position + 1, sizeof(int) * (size - position - 1));
+    size--;
+    *cost += change;
+    insertNode(node);
     return true;
 }
 
 //------------------------------------------------------------------------------
-// Save route to a TOUR file
+// Instance to edit
 
-bool Cycle::saveTour(const char *path) const
+Instance * Cycle::exclusive() const
 {
-    using namespace std;
-    ofstream file(path);
+    // A shared instance may be in use by a search, or by cycles of the old size
 
-    if (!file) {
-        cerr << "No se pudo abrir el archivo " << path << endl;
-        return false;
+    if (view || !instance || instance.use_count() != 1) {
+        std::cerr << "The instance cannot be edited while other cycles share it.\n";
+        return NULL;
     }
 
-    // Head
+    return const_cast<Instance *>(instance.get());
+}
+
+//------------------------------------------------------------------------------
+// Insert a node of the instance where it costs the least
 
-    file << "NAME : " << path << endl;
-    file << "TYPE : TOUR\n";
-    file << "DIMENSION : " << size << endl;
-    file << "TOUR_SECTION\n";
+void Cycle::insertNode(int node)
+{
+    const int count = instance->getNeighbors();
+    const int *row = instance->neighbors() + (size_t)node * count;
+    std::vector<int> positions(instance->getSize(), -1);
+    float best = FLT_MAX;
+    int at = size;
 
-    // List of node indexes (edges)
+    if (size < 2)
+        best = size == 0 ? 0.0 : 2 * distance(edges[0], node);
 
     for (int i = 0; i < size; i++)
-        file << edges[i] + 1 << endl;
+        positions[edges[i]] = i;
 
-    file << "EOF";
+    /*
+     * The candidate lists are the spatial index: the cheapest insertion is
+     * almost always next to one of the nearest nodes, before or after it.
+     */
 
-    if (!file) {
-        cerr << "Error de escritura en archivo.\n";
-        file.close();
-        return false;
+    for (int k = 0; k < count && size >= 2; k++) {
+        const int p = positions[row[k]];
+
+        if (p < 0)
+            continue;
+
+        for (int side = 0; side < 2; side++) {
+            const int a = edges[(p + size - 1 + side) % size];
+            const int b = edges[(p + side) % size];
+            const float change = distance(a, node) + distance(node, b) - distance(a, b);
+
+            if (change < best) {
+                best = change;
+                at = p + side;
+            }
+        }
     }
 
-    file.close();
-    return true;
+    // Without any neighbor in the path, the node closes the cycle
+
+    if (best == FLT_MAX)
+        best = distance(edges[size - 1], node) + distance(node, edges[0]) - distance(edges[size - 1], edges[0]);
+
+    memmove(edges + at + 1, edges + at, sizeof(int) * (size - at));
+    edges[at] = node;
+    size++;
+    *cost += best;
+    hashed = false;
 }
 
 //------------------------------------------------------------------------------
-// Set path
+// Cost of taking a node out of the path
 
-bool Cycle::setPath(const Cycle &other)
+float Cycle::removalCost(int position) const
 {
-    if (other.size != size)
-        return false;
+    const int node = edges[position];
+    const int previous = edges[(position + size - 1) % size];
+    const int next = edges[(position + 1) % size];
 
-    memcpy(edges, other.edges, sizeof(int) * size);
-    cost = other.cost;
-    return true;
+    if (size <= 2)
+        return -*cost;
+
+    return distance(previous, next) - distance(previous, node) - distance(node, next);
 }
 
 //------------------------------------------------------------------------------
@@ -381,8 +415,9 @@ bool Cycle::setPath(const Cycle &other)
 
 void Cycle::clearPath()
 {
-    cost = FLT_MAX;
+    *cost = FLT_MAX;
     memset(edges, 0, sizeof(int) * size);
+    hashed = false;
 }
 
 //------------------------------------------------------------------------------
@@ -393,13 +428,14 @@ void Cycle::sortPath()
     for (int i = 0; i < size; i++)
         edges[i] = i;
 
+    hashed = false;
     updateCost();
 }
 
 //------------------------------------------------------------------------------
 // Shuffle path
 
-void Cycle::shufflePath(std::mt19937 &generator)
+void Cycle::shufflePath(Algorithms::Generator &generator)
 {
     const int bound = size - 1;
     int i, j;
@@ -426,13 +462,14 @@ void Cycle::shufflePath(std::mt19937 &generator)
         edges[i] = auxEdge;
     }
 
+    hashed = false;
     updateCost();
 }
 
 //------------------------------------------------------------------------------
 // Shuffle subpath
 
-void Cycle::shuffleSubpath(int count, std::mt19937 &generator)
+void Cycle::shuffleSubpath(int count, Algorithms::Generator &generator)
 {
     const int bound = count - 1;
     int begin;
@@ -465,6 +502,7 @@ void Cycle::shuffleSubpath(int count, std::mt19937 &generator)
         edges[begin + i] = auxEdge;
     }
 
+    hashed = false;
     updateCost();
 }
 
@@ -473,10 +511,15 @@ void Cycle::shuffleSubpath(int count, std::mt19937 &generator)
 
 void Cycle::invertSubpath(int first, int count)
 {
+    const int before = (first + size - 1) % size;
     const int last = first + count - 1;
     const int middle = count / 2;
+    float value = *cost;
+
+    value -= distance(edges[before], edges[first]) + distance(edges[last], edges[last + 1]);
 
-    cost -= distance(edges[(first + size - 1) % size], edges[first]) + distance(edges[last], edges[last + 1]);
+    if (hashed)
+        pathHash ^= edgeKey(edges[before], edges[first]) ^ edgeKey(edges[last], edges[last + 1]);
 
     for (int i = 0; i < middle; i++) {
         register int auxEdge = edges[first + i];
@@ -484,7 +527,11 @@ void Cycle::invertSubpath(int first, int count)
         edges[last - i] = auxEdge;
     }
 
-    cost += distance(edges[(first + size - 1) % size], edges[first]) + distance(edges[last], edges[last + 1]);
+    value += distance(edges[before], edges[first]) + distance(edges[last], edges[last + 1]);
+    *cost = value;
+
+    if (hashed)
+        pathHash ^= edgeKey(edges[before], edges[first]) ^ edgeKey(edges[last], edges[last + 1]);
 }
 
 //------------------------------------------------------------------------------
@@ -496,6 +543,7 @@ void Cycle::swap(int i, int j)
     const int nextI = (i + 1) % size;
     const int prevJ = (j + size - 1) % size;
     const int nextJ = (j + 1) % size;
+    float value = *cost;
 
     /*
       * Update cost
@@ -504,16 +552,35 @@ void Cycle::swap(int i, int j)
       */
 
     if (nextI == j) {
-        cost -= distance(edges[prevI], edges[i]) + distance(edges[j], edges[nextJ]);
-        cost += distance(edges[prevI], edges[j]) + distance(edges[i], edges[nextJ]);
+        value -= distance(edges[prevI], edges[i]) + distance(edges[j], edges[nextJ]);
+        value += distance(edges[prevI], edges[j]) + distance(edges[i], edges[nextJ]);
     } else if (nextJ == i) {
-        cost -= distance(edges[prevJ], edges[j]) + distance(edges[i], edges[nextI]);
-        cost += distance(edges[prevJ], edges[i]) + distance(edges[j], edges[nextI]);
+        value -= distance(edges[prevJ], edges[j]) + distance(edges[i], edges[nextI]);
+        value += distance(edges[prevJ], edges[i]) + distance(edges[j], edges[nextI]);
     } else {
-        cost -= distance(edges[prevI], edges[i]) + distance(edges[i], edges[nextI]);
-        cost -= distance(edges[prevJ], edges[j]) + distance(edges[j], edges[nextJ]);
-        cost += distance(edges[prevI], edges[j]) + distance(edges[j], edges[nextI]);
-        cost += distance(edges[prevJ], edges[i]) + distance(edges[i], edges[nextJ]);
+        value -= distance(edges[prevI], edges[i]) + distance(edges[i], edges[nextI]);
+        value -= distance(edges[prevJ], edges[j]) + distance(edges[j], edges[nextJ]);
+        value += distance(edges[prevI], edges[j]) + distance(edges[j], edges[nextI]);
+        value += distance(edges[prevJ], edges[i]) + distance(edges[i], edges[nextJ]);
+    }
+
+    *cost = value;
+
+    // The hash gets the same edges (two nodes have the same edges either way)
+
+    if (hashed && size > 2) {
+        if (nextI == j) {
+            pathHash ^= edgeKey(edges[prevI], edges[i]) ^ edgeKey(edges[j], edges[nextJ]);
+            pathHash ^= edgeKey(edges[prevI], edges[j]) ^ edgeKey(edges[i], edges[nextJ]);
+        } else if (nextJ == i) {
+            pathHash ^= edgeKey(edges[prevJ], edges[j]) ^ edgeKey(edges[i], edges[nextI]);
+            pathHash ^= edgeKey(edges[prevJ], edges[i]) ^ edgeKey(edges[j], edges[nextI]);
+        } else {
+            pathHash ^= edgeKey(edges[prevI], edges[i]) ^ edgeKey(edges[i], edges[nextI]);
+            pathHash ^= edgeKey(edges[prevJ], edges[j]) ^ edgeKey(edges[j], edges[nextJ]);
+            pathHash ^= edgeKey(edges[prevI], edges[j]) ^ edgeKey(edges[j], edges[nextI]);
+            pathHash ^= edgeKey(edges[prevJ], edges[i]) ^ edgeKey(edges[i], edges[nextJ]);
+        }
     }
 
     // Swap noded
@@ -524,35 +591,40 @@ void Cycle::swap(int i, int j)
 }
 
 //------------------------------------------------------------------------------
-// Update distance matrix
+// Calculate cost of the cycle
 
-void Cycle::updateDistances()
+void Cycle::updateCost()
 {
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j <= i; j++) {
-            if (i == j)
-                distances[i * size + j] = 0.0;
-            else {
-                register float x = vertices[i].x - vertices[j].x;
-                register float y = vertices[i].y - vertices[j].y;
-                distances[i * size + j] = distances[j * size + i] = floor(sqrt(x * x + y * y));
-            }
-        }
+    float value = 0.0;
+
+    if (size >= 2) {
+        for (int i = 1; i < size; i++)
+            value += distance(edges[i - 1], edges[i]);
+
+        value += distance(edges[0], edges[size - 1]);
     }
+
+    *cost = value;
 }
 
 //------------------------------------------------------------------------------
-// Calculate cost of the cycle
+// Hash of the tour
 
-void Cycle::updateCost()
+uint64_t Cycle::hash() const
 {
-    cost = 0.0;
+    uint64_t value = 0;
 
-    if (size < 2)
-        return;
+    if (hashed)
+        return pathHash;
 
-    for (int i = 1; i < size; i++)
-        cost += distance(edges[i - 1], edges[i]);
+    if (size >= 2) {
+        for (int i = 1; i < size; i++)
+            value ^= edgeKey(edges[i - 1], edges[i]);
+
+        value ^= edgeKey(edges[0], edges[size - 1]);
+    }
 
-    cost += distance(edges[0], edges[size - 1]);
+    pathHash = value;
+    hashed = true;
+    return value;
 }
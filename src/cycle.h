@@ -7,22 +7,25 @@
 #ifndef CYCLE_H
 #define CYCLE_H
 
-#include <random>
+#include <memory>
+#include <cstdint>
+#include "instance.h"
+#include "generator.h"
 
 /**
  * @brief Cycle Class
  *
- * Provides the storage structure of a 2D point Hamiltonian cycle.
+ * Provides the storage structure of a 2D point Hamiltonian cycle. The nodes
+ * and the distance matrix belong to an Instance, shared by all the copies of
+ * the cycle, so that a cycle only owns its path.
  */
 class Cycle
 {
 public:
 
-    /// Structure of each node of the graph
-    struct Vertex {
-        float x;
-        float y;
-    };
+    typedef Instance::Vertex Vertex;
+    typedef Instance::Layout Layout;
+    typedef Instance::Order Order;
 
     /**
      * @brief Default constructor
@@ -41,8 +44,9 @@ public:
      * @brief Constructor from file
      * @param path Path of a TSP file.
      *
-     * If the TSP file cannot be read, the program is forced to close.
-     * To detect errors, create an empty graph and call loadTSP().
+     * If the TSP file cannot be read, the cycle is left empty (getSize() is
+     * zero). To get the result directly, create an empty graph and call
+     * loadTsp().
      */
     explicit Cycle(const char *path);
 
@@ -52,12 +56,24 @@ public:
      */
     Cycle(const Cycle &other);
 
+    /**
+     * @brief View constructor
+     * @param sample Cycle whose instance is shared.
+     * @param edges Storage for the path (getSize() nodes).
+     * @param cost Storage for the cost.
+     *
+     * Creates a cycle over external memory, such as a Population arena. The
+     * view does not own its storage, and copies of it are regular cycles.
+     */
+    Cycle(const Cycle &sample, int *edges, float *cost);
+
     /// Destructor
     ~Cycle();
 
     /**
      * @brief Assignment operator
      * @param other Source object.
+     * @pre A view can only be assigned cycles of the same size.
      * @return Reference to the object itself.
      */
     Cycle & operator=(const Cycle &other);
@@ -65,10 +81,40 @@ public:
     /**
      * @brief Load nodes from a TSP file
      * @param path File path.
+     * @param layout Storage layout of the distance matrix.
+     * @param order Numbering of the nodes.
      * @post The distance matrix is updated implicitly.
+     *
+     * With the Hilbert order, nodes that are close in the plane get close
+     * indices, so do their rows in the distance matrix. The original numbers
+     * are kept for loadTour(), saveTour() and idAt().
+     *
+     * A binary instance compiled by Instance::saveBinary() is mapped instead
+     * of parsed, keeping the layout and order it was compiled with.
+     *
      * @return Whether it was read correctly.
      */
-    bool loadTsp(const char *path);
+    bool loadTsp(const char *path, Layout layout = Instance::Packed, Order order = Instance::Original);
+
+    /**
+     * @brief Load nodes from memory
+     * @param vertices Coordinates of the nodes.
+     * @param size Number of nodes.
+     * @param layout Storage layout of the distance matrix.
+     * @param order Numbering of the nodes.
+     * @post The path is reset to the canonical order.
+     * @return Whether the nodes were accepted.
+     */
+    bool loadVertices(const Vertex *vertices, int size, Layout layout = Instance::Packed, Order order = Instance::Original);
+
+    /**
+     * @brief Map a raw distance matrix
+     * @param path Path of a file with the full matrix, row by row.
+     * @param weight Type of the cells.
+     * @post The path is reset to the canonical order.
+     * @return Whether the file was mapped (see Instance::loadMatrix()).
+     */
+    bool loadMatrix(const char *path, Instance::Weight weight);
 
     /**
      * @brief Load path from a TOUR file
@@ -107,6 +153,61 @@ public:
      */
     bool setPath(const Cycle &other);
 
+    /**
+     * @brief Set a saved path
+     * @param edges Sequence of getSize() nodes.
+     * @param cost Cost of the path, as it was saved.
+     *
+     * The cost is not recalculated, since incremental updates may leave it a
+     * few bits away from a fresh sum, and a resumed search must see the same
+     * values as the original one.
+     */
+    void setPath(const int *edges, float cost);
+
+    /**
+     * @brief Set path from original node numbers
+     * @param ids Zero-based numbers of the nodes, as in the TSP file or as
+     *        given to loadVertices().
+     * @param count Number of nodes.
+     * @return Whether @p ids is a permutation of [0, getSize()[.
+     */
+    bool setTour(const int *ids, int count);
+
+    /**
+     * @brief Add a node and insert it in the path
+     * @param vertex Coordinates of the node.
+     *
+     * The node is added to the instance (see Instance::addVertex()) and
+     * inserted where it lengthens the path the least, next to one of its
+     * candidate neighbors. The cost is updated incrementally.
+     *
+     * @pre The path must be complete, and no other cycle may share the
+     *      instance (the copies made by a search must be gone).
+     * @return Whether the node was added, with index getSize() - 1.
+     */
+    bool insertVertex(const Vertex &vertex);
+
+    /**
+     * @brief Remove a node from the instance and from the path
+     * @param node Index of the node.
+     *
+     * Its neighbors in the path are joined, and the last node takes the index
+     * of the removed one (see Instance::removeVertex()).
+     *
+     * @pre Same as insertVertex().
+     * @return Whether the node was removed.
+     */
+    bool removeVertex(int node);
+
+    /**
+     * @brief Move a node and insert it again in the path
+     * @param node Index of the node.
+     * @param vertex New coordinates.
+     * @pre Same as insertVertex().
+     * @return Whether the node was moved.
+     */
+    bool moveVertex(int node, const Vertex &vertex);
+
     /**
      * @brief Sort path
      *
@@ -123,7 +224,7 @@ public:
      * algorithm produces cycles of period 2^19937 - 1 with a speed similar to
      * the standard C function.
      */
-    void shufflePath(std::mt19937 &generator);
+    void shufflePath(Algorithms::Generator &generator);
 
     /**
      * @brief Shuffle subpath
@@ -133,7 +234,7 @@ public:
      * Shuffles the sublist of size @p count starting at index @p begin.
      * If the sublist is of length 2, swap() is recommended.
      */
-    void shuffleSubpath(int count, std::mt19937 &generator);
+    void shuffleSubpath(int count, Algorithms::Generator &generator);
 
     /**
      * @brief Reverse subpath
@@ -160,7 +261,7 @@ public:
      */
     inline float getCost() const
     {
-        return cost;
+        return *cost;
     }
 
     /**
@@ -172,6 +273,24 @@ public:
         return size;
     }
 
+    /**
+     * @brief Get the layout of the distance matrix
+     * @return Layout chosen when the nodes were loaded.
+     */
+    inline Layout getLayout() const
+    {
+        return instance->getLayout();
+    }
+
+    /**
+     * @brief Get the instance
+     * @return Nodes and distances shared by this cycle.
+     */
+    inline const std::shared_ptr<const Instance> & getInstance() const
+    {
+        return instance;
+    }
+
     /**
      * @brief Constant reference to vertex
      * @param index Index of the vertex within the vector.
@@ -180,7 +299,7 @@ public:
      */
     inline const Vertex & vertexAt(int index) const
     {
-        return vertices[index];
+        return instance->vertexAt(index);
     }
 
     /**
@@ -194,14 +313,26 @@ public:
         return edges[index];
     }
 
+    /**
+     * @brief Original number of a node in the path
+     * @param index Index of the edge within the vector.
+     * @pre @index must be in the range [0, size[.
+     * @return Zero-based number that the node has in the TSP file.
+     */
+    inline int idAt(int index) const
+    {
+        return instance->idOf(edges[index]);
+    }
+
     /**
      * @brief Reference to edge (solution element)
      * @param index Index of the edge within the vector.
      * @pre @index must be in the range [0, size[.
-     * @return Constant reference to the indicated edge.
+     * @return Reference to the indicated edge.
      */
     inline int & edgeAt(int index)
     {
+        hashed = false;
         return edges[index];
     }
 
@@ -214,24 +345,72 @@ public:
      */
     inline float distance(int i, int j) const
     {
-        return distances[i * size + j];
+        return instance->distance(i, j);
+    }
+
+    /**
+     * @brief Hash of the tour
+     *
+     * XOR of edgeKey() over all the edges of the cycle, so it does not depend
+     * on the starting node or on the direction. The value is cached: swap()
+     * and invertSubpath() update it by XOR-ing the keys of the removed and
+     * the added edges, and setPath() copies it from the other cycle, so it
+     * costs O(1) after those. Any other change of the path (including a
+     * write through edgeAt()) makes the next call sum all the edges again.
+     *
+     * @return 64-bit hash of the set of edges.
+     */
+    uint64_t hash() const;
+
+    /**
+     * @brief Key of an undirected edge
+     * @param a Index of one of the nodes.
+     * @param b Index of the other node.
+     * @return Pseudorandom key, equal for (a, b) and (b, a).
+     */
+    static inline uint64_t edgeKey(int a, int b)
+    {
+        return mix(mix(a) + mix(b));
     }
 
 private:
 
+    std::shared_ptr<const Instance> instance;   ///< Nodes and distances
     int size;           ///< Graph size
-    float cost;         ///< Cycle cost
-    Vertex *vertices;   ///< Vector of nodes
+    float *cost;        ///< Cycle cost (points to ownCost unless it is a view)
+    float ownCost;      ///< Storage for the cost of a regular cycle
     int *edges;         ///< Edges as sequence of nodes (solution vector)
-    float *distances;   ///< Symmetric distance matrix
+    bool view;          ///< Whether edges and cost are external
+    mutable uint64_t pathHash;  ///< Cached value of hash()
+    mutable bool hashed;        ///< Whether pathHash matches the path
 
     /**
-     * @brief Update distance matrix
-     *
-     * It must be called if any of the nodes are modified, and is necessary so
-     * that distance() and getCost() return correct results.
+     * @brief Instance to edit
+     * @return Instance of the cycle, or NULL if it is shared.
      */
-    void updateDistances();
+    Instance * exclusive() const;
+
+    /**
+     * @brief Insert a node of the instance where it costs the least
+     * @param node Index of a node that is not in the path.
+     */
+    void insertNode(int node);
+
+    /**
+     * @brief Cost of taking a node out of the path
+     * @param position Index of the node within the path.
+     * @return Change of the cost.
+     */
+    float removalCost(int position) const;
+
+    /// SplitMix64 finalizer
+    static inline uint64_t mix(uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
 
 public:
     /**
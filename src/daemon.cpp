@@ -0,0 +1,439 @@
+/**
+ * @file daemon.cpp
+ * @brief Definition of the Daemon class
+ * @date October 18, 2026
+ */
+
+#include "daemon.h"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <sstream>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace Tsp
+{
+
+//------------------------------------------------------------------------------
+// Parse the fields of a solve request
+
+bool parse(const std::string &text, Request &request, std::string &field)
+{
+    std::istringstream fields(text);
+    Algorithms::Settings &settings = request.settings;
+    bool valid = true;
+
+    while (valid && fields >> field) {
+        const size_t equal = field.find('=');
+        const std::string key = field.substr(0, equal);
+        const char *value = equal == std::string::npos ? "" : field.c_str() + equal + 1;
+
+        if (key == "id")
+            request.id = value;
+        else if (key == "tsp")
+            request.path = value;
+        else if (key == "out")
+            request.tour = value;
+        else if (key == "points") {
+            char *end = (char *)value;
+
+            while (*end != '\0') {
+                Point point;
+                point.x = strtof(end, &end);
+
+                if (*end++ != ',') {
+                    valid = false;
+                    break;
+                }
+
+                point.y = strtof(end, &end);
+                request.points.push_back(point);
+
+                if (*end == ';')
+                    end++;
+                else if (*end != '\0') {
+                    valid = false;
+                    break;
+                }
+            }
+        } else if (key == "algorithm") {
+            Algorithms::Algorithm algorithm;
+
+            if ((valid = Algorithms::parse(value, algorithm))) {
+                const long timeLimit = settings.timeLimit;
+                settings = Algorithms::Settings(algorithm, settings.seed);
+                settings.timeLimit = timeLimit;
+            }
+        } else if (key == "count")
+            settings.count = atoi(value);
+        else if (key == "seed")
+            settings.seed = strtoul(value, NULL, 10);
+        else if (key == "size")
+            settings.size = atoi(value);
+        else if (key == "processes")
+            settings.processes = atoi(value);
+        else if (key == "latency")
+            settings.migrLatency = atoi(value);
+        else if (key == "neighbor")
+            valid = Algorithms::parse(value, settings.neighbor);
+        else if (key == "scheme")
+            valid = Algorithms::parse(value, settings.scheme);
+        else if (key == "crossover")
+            valid = Algorithms::parse(value, settings.crossover);
+        else if (key == "hybridization")
+            valid = Algorithms::parse(value, settings.hybridization);
+        else if (key == "topology")
+            valid = Algorithms::parse(value, settings.topology);
+        else if (key == "time-limit")
+            valid = (settings.timeLimit = (long)(strtod(value, NULL) * 1000)) > 0;
+        else
+            valid = false;
+    }
+
+    return valid;
+}
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Daemon::Daemon(int workers, int capacity, Instance::Layout layout, Instance::Order order, ResultCache *results)
+{
+    this->layout = layout;
+    this->order = order;
+    this->results = results;
+    cached = 0;
+    this->capacity = capacity > 0 ? capacity : 1;
+    hits = 0;
+    misses = 0;
+    stopping = false;
+
+    for (int i = 0; i < (workers > 0 ? workers : 1); i++)
+        this->workers.push_back(std::thread(&Daemon::work, this));
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+
+Daemon::~Daemon()
+{
+    {
+        std::lock_guard<std::mutex> guard(jobsLock);
+        stopping = true;
+    }
+
+    jobsReady.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+//------------------------------------------------------------------------------
+// Serve requests from a pair of file descriptors
+
+void Daemon::serve(int input, int output)
+{
+    read(std::make_shared<Connection>(input, output, false));
+}
+
+//------------------------------------------------------------------------------
+// Serve the clients of a Unix domain socket
+
+bool Daemon::listen(const char *path)
+{
+    struct sockaddr_un address;
+    int server, client;
+
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return false;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    unlink(path);
+
+    server = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (server < 0 || bind(server, (struct sockaddr *)&address, sizeof(address)) < 0 || ::listen(server, SOMAXCONN) < 0) {
+        std::cerr << "Could not listen on " << path << ": " << strerror(errno) << std::endl;
+
+        if (server >= 0)
+            close(server);
+
+        return false;
+    }
+
+    while (true) {
+        client = accept(server, NULL, NULL);
+
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+
+            std::cerr << "Could not accept a client: " << strerror(errno) << std::endl;
+            close(server);
+            return false;
+        }
+
+        std::thread(&Daemon::read, this, std::make_shared<Connection>(client, client, true)).detach();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Read the requests of a client and wait for their answers
+
+void Daemon::read(std::shared_ptr<Connection> connection)
+{
+    FILE *file = fdopen(dup(connection->input), "r");
+    char *line = NULL;
+    size_t length = 0;
+    ssize_t count;
+
+    if (file == NULL)
+        return;
+
+    while ((count = getline(&line, &length, file)) > 0) {
+        std::string request(line, count);
+
+        while (!request.empty() && (request.back() == '\n' || request.back() == '\r'))
+            request.pop_back();
+
+        if (request.empty())
+            continue;
+        else if (request == "quit")
+            break;
+        else if (request == "stats") {
+            connection->reply(stats());
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(connection->lock);
+            connection->pending++;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(jobsLock);
+            jobs.push_back(Job());
+            jobs.back().connection = connection;
+            jobs.back().request = request;
+        }
+
+        jobsReady.notify_one();
+    }
+
+    free(line);
+    fclose(file);
+
+    std::unique_lock<std::mutex> guard(connection->lock);
+
+    while (connection->pending > 0)
+        connection->idle.wait(guard);
+}
+
+//------------------------------------------------------------------------------
+// Worker thread
+
+void Daemon::work()
+{
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> guard(jobsLock);
+
+            while (jobs.empty() && !stopping)
+                jobsReady.wait(guard);
+
+            if (jobs.empty())
+                return;
+
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        job.connection->reply(run(job.request));
+
+        std::lock_guard<std::mutex> guard(job.connection->lock);
+
+        if (--job.connection->pending == 0)
+            job.connection->idle.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Run a solve request and compose its answer
+
+std::string Daemon::run(const std::string &request)
+{
+    std::istringstream fields(request);
+    std::ostringstream answer;
+    std::string command, field;
+    std::shared_ptr<Problem> problem;
+    Request job;
+
+    fields >> command;
+
+    if (command != "solve")
+        return "- error unknown command " + command;
+
+    job.id = "-";
+    job.settings = Algorithms::Settings(Algorithms::Greedy, (unsigned int)time(NULL));
+
+    if (!parse(request.substr(command.size()), job, field))
+        return job.id + " error invalid field " + field;
+
+    // Clients do not get to write files as the daemon
+
+    if (!job.tour.empty())
+        return job.id + " error invalid field out=" + job.tour;
+
+    if (!job.path.empty())
+        problem = fetch(job.path);
+    else if (!job.points.empty()) {
+        problem = std::make_shared<Problem>();
+
+        if (!problem->load(job.points, layout, order))
+            problem.reset();
+    } else
+        return job.id + " error no tsp or points given";
+
+    if (!problem)
+        return job.id + " error could not load the problem";
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const Result result = problem->solve(job.settings, results);
+    const long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    if (result.cached) {
+        std::lock_guard<std::mutex> guard(cacheLock);
+        cached++;
+    }
+
+    answer << job.id << " ok " << result.cost << " " << elapsed;
+
+    for (size_t i = 0; i < result.tour.size(); i++)
+        answer << " " << result.tour[i] + 1;
+
+    return answer.str();
+}
+
+//------------------------------------------------------------------------------
+// Statistics of the cache
+
+std::string Daemon::stats()
+{
+    std::lock_guard<std::mutex> guard(cacheLock);
+    std::ostringstream answer;
+
+    answer << "stats entries=" << cache.size() << " hits=" << hits << " misses=" << misses
+           << " workers=" << workers.size() << " cached=" << cached;
+
+    return answer.str();
+}
+
+//------------------------------------------------------------------------------
+// Problem of a file, from the cache if it was not modified
+
+std::shared_ptr<Problem> Daemon::fetch(const std::string &path)
+{
+    struct stat status;
+    std::shared_ptr<Problem> problem;
+
+    if (stat(path.c_str(), &status) < 0)
+        return problem;
+
+    {
+        std::lock_guard<std::mutex> guard(cacheLock);
+
+        for (std::list<Entry>::iterator it = cache.begin(); it != cache.end(); ++it) {
+            if (it->path == path && it->modified == status.st_mtime) {
+                cache.splice(cache.begin(), cache, it);
+                hits++;
+                return it->problem;
+            }
+        }
+
+        misses++;
+    }
+
+    // Load outside the lock, so that other requests are not held
+
+    problem = std::make_shared<Problem>();
+
+    if (!problem->load(path.c_str(), layout, order))
+        return std::shared_ptr<Problem>();
+
+    std::lock_guard<std::mutex> guard(cacheLock);
+
+    for (std::list<Entry>::iterator it = cache.begin(); it != cache.end(); ++it) {
+        if (it->path == path) {
+            cache.erase(it);
+            break;
+        }
+    }
+
+    cache.push_front(Entry());
+    cache.front().path = path;
+    cache.front().modified = status.st_mtime;
+    cache.front().problem = problem;
+
+    if (cache.size() > capacity)
+        cache.pop_back();
+
+    return problem;
+}
+
+//------------------------------------------------------------------------------
+// Connection: constructor
+
+Daemon::Connection::Connection(int input, int output, bool socket)
+{
+    this->input = input;
+    this->output = output;
+    this->socket = socket;
+    pending = 0;
+}
+
+//------------------------------------------------------------------------------
+// Connection: destructor (closes the socket)
+
+Daemon::Connection::~Connection()
+{
+    if (socket)
+        close(input);
+}
+
+//------------------------------------------------------------------------------
+// Connection: write an answer line
+
+void Daemon::Connection::reply(const std::string &answer)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    const std::string line = answer + "\n";
+    size_t done = 0;
+    ssize_t count;
+
+    while (done < line.size()) {
+        if (socket)
+            count = send(output, line.data() + done, line.size() - done, MSG_NOSIGNAL);
+        else
+            count = write(output, line.data() + done, line.size() - done);
+
+        if (count < 0 && errno == EINTR)
+            continue;
+        else if (count <= 0)
+            return;
+
+        done += count;
+    }
+}
+
+}
@@ -0,0 +1,166 @@
+/**
+ * @file daemon.h
+ * @brief Declaration of the Daemon class
+ * @date October 18, 2026
+ */
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <string>
+#include <list>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <ctime>
+#include "tsp.h"
+
+namespace Tsp
+{
+
+/// Solve request, in the text form of Daemon and Batch
+struct Request {
+    std::string id;             ///< Identifier of the answer
+    std::string path;           ///< TSP file (empty if points are given)
+    std::vector<Point> points;  ///< Nodes given in the request
+    std::string tour;           ///< Destination of the tour (empty for none)
+    Algorithms::Settings settings;  ///< Algorithm and parameters
+};
+
+/**
+ * @brief Parse the fields of a solve request
+ * @param text Fields separated by spaces, as KEY=VALUE.
+ * @param request Destination, with the defaults already set.
+ * @param field Destination of the first invalid field.
+ *
+ * Fields are applied in order, so the algorithm resets the parameters (but
+ * the seed and the time limit). The keys are those of the daemon protocol,
+ * and "out" for the destination of the tour.
+ *
+ * @return Whether every field was valid.
+ */
+bool parse(const std::string &text, Request &request, std::string &field);
+
+/**
+ * @brief Daemon Class
+ *
+ * Long-running solver that reads requests line by line, from a pair of file
+ * descriptors (serve()) or from the clients of a Unix domain socket (listen()),
+ * and runs them on a pool of worker threads. Answers carry the identifier of
+ * their request, since they are written as soon as each one is done.
+ *
+ * Problems loaded from files stay in an LRU cache, along with their distance
+ * matrix and candidate lists, so a request only pays for the search unless
+ * the file was modified. With a ResultCache, a request already solved with
+ * the same settings is answered without a search.
+ *
+ * Protocol (one request per line, fields separated by spaces):
+ *
+ *     solve [id=ID] (tsp=PATH | points=X,Y;X,Y;...) [algorithm=NAME]
+ *           [count=N] [seed=N] [size=N] [processes=N] [latency=N]
+ *           [neighbor=NAME] [scheme=NAME] [crossover=NAME]
+ *           [hybridization=NAME] [topology=NAME] [time-limit=SECONDS]
+ *     stats
+ *     quit
+ *
+ * Answers:
+ *
+ *     ID ok COST MILLISECONDS NODE NODE ...
+ *     ID error MESSAGE
+ *     stats entries=N hits=N misses=N workers=N cached=N
+ */
+class Daemon
+{
+public:
+
+    /**
+     * @brief Constructor
+     * @param workers Number of worker threads.
+     * @param capacity Maximum number of problems in the cache.
+     * @param layout Storage layout of the loaded problems.
+     * @param order Internal numbering of the loaded problems.
+     * @param results Cache of results shared with other processes (NULL for
+     *        none), which must outlive the daemon.
+     */
+    Daemon(int workers, int capacity, Instance::Layout layout = Instance::Packed, Instance::Order order = Instance::Original, ResultCache *results = NULL);
+
+    /// Destructor: finishes the pending requests and stops the workers
+    ~Daemon();
+
+    /**
+     * @brief Serve requests from a pair of file descriptors
+     * @param input Descriptor where the requests are read.
+     * @param output Descriptor where the answers are written.
+     *
+     * It returns after the end of the input or a quit request, once every
+     * answer has been written.
+     */
+    void serve(int input, int output);
+
+    /**
+     * @brief Serve the clients of a Unix domain socket
+     * @param path Path of the socket, replaced if it exists.
+     * @return Only if the socket cannot be created (false).
+     */
+    bool listen(const char *path);
+
+private:
+
+    /// Client of the daemon
+    struct Connection {
+        int input;              ///< Descriptor of the requests
+        int output;             ///< Descriptor of the answers
+        bool socket;            ///< Whether the descriptors belong to a socket
+        int pending;            ///< Requests not answered yet
+        std::mutex lock;        ///< Guards output and pending
+        std::condition_variable idle;
+
+        Connection(int input, int output, bool socket);
+        ~Connection();
+        void reply(const std::string &answer);
+    };
+
+    /// Request waiting for a worker
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        std::string request;
+    };
+
+    /// Problem in the cache
+    struct Entry {
+        std::string path;
+        time_t modified;        ///< Modification time of the file
+        std::shared_ptr<Problem> problem;
+    };
+
+    Instance::Layout layout;
+    Instance::Order order;
+    size_t capacity;            ///< Maximum number of entries
+    std::list<Entry> cache;     ///< Most recently used first
+    long hits;                  ///< Requests served from the cache
+    long misses;                ///< Requests that loaded a file
+    ResultCache *results;       ///< Cache of results (NULL for none)
+    long cached;                ///< Requests answered from the results
+    std::mutex cacheLock;
+    std::deque<Job> jobs;       ///< Requests waiting for a worker
+    bool stopping;              ///< Whether the workers must finish
+    std::mutex jobsLock;
+    std::condition_variable jobsReady;
+    std::vector<std::thread> workers;
+
+    Daemon(const Daemon &);
+    Daemon & operator=(const Daemon &);
+
+    void read(std::shared_ptr<Connection> connection);
+    void work();
+    std::string run(const std::string &request);
+    std::string stats();
+    std::shared_ptr<Problem> fetch(const std::string &path);
+};
+
+}
+
+#endif /* DAEMON_H */
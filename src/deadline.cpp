@@ -0,0 +1,83 @@
+/**
+ * @file deadline.cpp
+ * @brief Definition of the Deadline class
+ * @date October 19, 2026
+ */
+
+#include "deadline.h"
+#include <climits>
+
+namespace Algorithms
+{
+
+std::atomic<unsigned long> Deadline::interrupts(0);
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Deadline::Deadline(long milliseconds)
+{
+    last = Clock::now();
+    end = last + std::chrono::milliseconds(milliseconds);
+    limited = milliseconds > 0;
+    passed = false;
+    stride = 1;
+    countdown = limited ? 1 : LONG_MAX;
+    budget = countdown;
+    spent = 0;
+    epoch = interrupts.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Stop every search in progress
+
+void Deadline::interrupt()
+{
+    interrupts.fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Count the interruptions
+
+unsigned long Deadline::interruptions()
+{
+    return interrupts.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Read the clock and adapt the stride
+
+bool Deadline::check()
+{
+    spent += budget - countdown;
+
+    if (!limited) {
+        countdown = budget = LONG_MAX;
+        return false;
+    }
+
+    if (passed) {
+        countdown = budget = 1;
+        return true;
+    }
+
+    const Clock::time_point now = Clock::now();
+    const long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+
+    if (now >= end) {
+        passed = true;
+        countdown = budget = 1;
+        return true;
+    }
+
+    if (elapsed < DEADLINE_PERIOD / 2 && stride < LONG_MAX / 2)
+        stride *= 2;
+    else if (elapsed > DEADLINE_PERIOD * 2 && stride > 1)
+        stride /= 2;
+
+    last = now;
+    countdown = budget = stride;
+    return false;
+}
+
+}
@@ -0,0 +1,99 @@
+/**
+ * @file deadline.h
+ * @brief Declaration of the Deadline class
+ * @date October 19, 2026
+ */
+
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+
+#define DEADLINE_PERIOD 1000    ///< Target microseconds between clock reads
+
+namespace Algorithms
+{
+
+/**
+ * @brief Wall-clock budget of a search
+ *
+ * Algorithms call expired() once per step of their main loops and stop as
+ * soon as it is true, keeping the best tour found so far. Steps range from a
+ * few moves to a whole neighborhood, so the clock is not read on every call:
+ * the number of calls between reads doubles or halves until reads happen
+ * about every DEADLINE_PERIOD microseconds.
+ *
+ * interrupt() expires every deadline that exists at the time, and it is safe
+ * to call from a signal handler. Deadlines created afterwards are not
+ * affected, so that an interruption stops the searches in progress but not
+ * every later search of the process. A deadline must not be shared by several
+ * threads.
+ */
+class Deadline
+{
+public:
+
+    /**
+     * @brief Constructor
+     * @param milliseconds Budget from now (0 for none).
+     */
+    explicit Deadline(long milliseconds = 0);
+
+    /**
+     * @brief Check the budget
+     * @return Whether the search must stop.
+     */
+    inline bool expired()
+    {
+        if (interrupts.load(std::memory_order_relaxed) != epoch)
+            return true;
+
+        if (--countdown > 0)
+            return false;
+
+        return check();
+    }
+
+    /**
+     * @brief Steps of the search
+     * @return Number of calls to expired() so far, while not interrupted.
+     */
+    inline long getSteps() const
+    {
+        return spent + (budget - countdown);
+    }
+
+    /// Stop every search in progress
+    static void interrupt();
+
+    /**
+     * @brief Count the interruptions
+     *
+     * A task was interrupted if the count changed since it started.
+     *
+     * @return Number of calls to interrupt() so far.
+     */
+    static unsigned long interruptions();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point end;      ///< End of the budget
+    Clock::time_point last;     ///< Last time the clock was read
+    bool limited;               ///< Whether there is a budget
+    bool passed;                ///< Whether the end was reached
+    long stride;                ///< Calls between clock reads
+    long countdown;             ///< Calls left until the next read
+    long budget;                ///< Countdown set by the last read
+    long spent;                 ///< Calls before the last read
+    unsigned long epoch;        ///< Interruptions before the construction
+
+    static std::atomic<unsigned long> interrupts;
+
+    bool check();
+};
+
+}
+
+#endif /* DEADLINE_H */
@@ -7,7 +7,17 @@
 
 namespace Algorithms
 {
-void descendantSearch(Cycle &data, int count, unsigned int seed)
+void descendantSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline)
+{
+    Generator generator(seed);
+
+    // Generate initial solution
+
+    data.shufflePath(generator);
+    descendantSearch(data, count, generator, deadline);
+}
+
+void descendantSearch(Cycle &data, int count, Generator &generator, Deadline &deadline)
 {
     const int N1 = data.getSize() * (data.getSize() - 1) / 2;
     const int N2 = 24 * (data.getSize() - 3);
@@ -15,15 +25,10 @@ void descendantSearch(Cycle &data, int count, unsigned int seed)
     const int NMAX = count * data.getSize();
     int nTotal = 1;
     int k = 1;
-    std::mt19937 generator(seed);
     Cycle &curCycle = data;     // Current solution (to be optimized)
     Cycle auxCycle = data;      // Auxiliary neighbor solution
     Cycle bestNeighbor = data;  // Best neighbor solution
 
-    // Generate initial solution
-
-    curCycle.shufflePath(generator);
-
     do {
         bestNeighbor.setPath(curCycle);
         auxCycle.setPath(curCycle);
@@ -78,6 +83,6 @@ void descendantSearch(Cycle &data, int count, unsigned int seed)
         } else
             k++;
 
-    } while (k <= 3 && nTotal <= NMAX);
+    } while (k <= 3 && nTotal <= NMAX && !deadline.expired());
 }
 }
@@ -0,0 +1,436 @@
+/**
+ * @file eax.cpp
+ * @brief Definition of the Eax class
+ * @date October 18, 2026
+ */
+
+#include "eax.h"
+#include <cfloat>
+#include <cstring>
+#include "algorithms.h"
+#include "allocator.h"
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Eax::Eax(const Cycle &sample)
+{
+    size = sample.getSize();
+    instance = sample.getInstance();
+    neighbors = instance->neighbors();
+    count = instance->getNeighbors();
+
+    adjacentA = Allocator::allocate<int>(2 * size);
+    adjacentB = Allocator::allocate<int>(2 * size);
+    openA = Allocator::allocate<int>(2 * size);
+    openB = Allocator::allocate<int>(2 * size);
+    trail = Allocator::allocate<int>(2 * size + 2);
+    visits = Allocator::allocate<int>(2 * size);
+    cycleNodes = Allocator::allocate<int>(2 * size);
+    cycleStarts = Allocator::allocate<int>(size + 2);
+    order = Allocator::allocate<int>(size + 1);
+    adjacent = Allocator::allocate<int>(2 * size);
+    best = Allocator::allocate<int>(2 * size);
+    subtours = Allocator::allocate<int>(size);
+    subtourSizes = Allocator::allocate<int>(size);
+    subtourNodes = Allocator::allocate<int>(size);
+    alive = Allocator::allocate<int>(size);
+    stamps = Allocator::allocate<unsigned int>(size, true);
+    stamp = 0;
+    cycles = 0;
+
+    for (int i = 0; i < 2 * size; i++)
+        visits[i] = -1;
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+
+Eax::~Eax()
+{
+    Allocator::release(adjacentA);
+    Allocator::release(adjacentB);
+    Allocator::release(openA);
+    Allocator::release(openB);
+    Allocator::release(trail);
+    Allocator::release(visits);
+    Allocator::release(cycleNodes);
+    Allocator::release(cycleStarts);
+    Allocator::release(order);
+    Allocator::release(adjacent);
+    Allocator::release(best);
+    Allocator::release(subtours);
+    Allocator::release(subtourSizes);
+    Allocator::release(subtourNodes);
+    Allocator::release(alive);
+    Allocator::release(stamps);
+}
+
+//------------------------------------------------------------------------------
+// Cross two tours
+
+void Eax::cross(const Cycle &father, const Cycle &mother, Cycle &child, Strategy strategy, Algorithms::Generator &generator)
+{
+    const int offset = Algorithms::random(generator, size);
+    float bestGain = FLT_MAX;
+    int node, previous, next;
+
+    build(father, adjacentA);
+    build(mother, adjacentB);
+
+    // Edges shared by both parents never take part in an AB-cycle
+
+    for (int i = 0; i < 2 * size; i++) {
+        const int *pair = adjacentB + (i & ~1);
+        openA[i] = (pair[0] == adjacentA[i] || pair[1] == adjacentA[i]) ? -1 : adjacentA[i];
+        pair = adjacentA + (i & ~1);
+        openB[i] = (pair[0] == adjacentB[i] || pair[1] == adjacentB[i]) ? -1 : adjacentB[i];
+    }
+
+    cycles = 0;
+    cycleStarts[0] = 0;
+
+    for (int i = 0; i < size; i++) {
+        node = (offset + i) % size;
+
+        if (openA[2 * node] != -1 || openA[2 * node + 1] != -1)
+            trace(node, generator);
+    }
+
+    if (cycles == 0) {
+        child.setPath(father);
+        return;
+    }
+
+    for (int i = 0; i < cycles; i++) {
+        const int j = Algorithms::random(generator, i + 1);
+        order[i] = order[j];
+        order[j] = i;
+    }
+
+    for (int i = 0; i < cycles && i < EAX_CHILDREN; i++) {
+        const float gain = assemble(order[i], strategy);
+
+        if (gain < bestGain) {
+            bestGain = gain;
+            memcpy(best, adjacent, sizeof(int) * 2 * size);
+        }
+    }
+
+    // Write the best child as a sequence from node 0
+
+    node = 0;
+    previous = -1;
+
+    for (int i = 0; i < size; i++) {
+        child.edgeAt(i) = node;
+        next = walk(best, node, previous);
+        previous = node;
+        node = next;
+    }
+
+    child.updateCost();
+}
+
+//------------------------------------------------------------------------------
+// Replace a neighbor of a node in an adjacency table
+
+void Eax::link(int *table, int node, int from, int to)
+{
+    int *pair = table + 2 * node;
+
+    if (pair[0] == from)
+        pair[0] = to;
+    else
+        pair[1] = to;
+}
+
+//------------------------------------------------------------------------------
+// Adjacency table of a tour: previous and next node of each one
+
+void Eax::build(const Cycle &tour, int *table)
+{
+    int node = tour.edgeAt(size - 1);
+
+    for (int i = 0; i < size; i++) {
+        const int next = tour.edgeAt(i);
+        table[2 * node + 1] = next;
+        table[2 * next] = node;
+        node = next;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Walk from a node alternating open edges of the father and the mother. Every
+// time the walk comes back to a node it has visited with the same parity, the
+// closed part is an AB-cycle: it is stored and cut from the walk.
+
+void Eax::trace(int start, Algorithms::Generator &generator)
+{
+    int length = 1;
+
+    trail[0] = start;
+    visits[2 * start] = 0;
+
+    /*
+     * Every node but the ends of the walk has as many open A-edges as open
+     * B-edges, so the walk can always go on, and it ends when it is back at
+     * the start without open A-edges.
+     */
+
+    while (length > 1 || openA[2 * start] != -1 || openA[2 * start + 1] != -1) {
+        const int node = trail[length - 1];
+        int *open = (length & 1) ? openA : openB;
+        int slot = 2 * node;
+
+        if (open[slot] == -1 || (open[slot + 1] != -1 && Algorithms::random(generator, 2)))
+            slot++;
+
+        const int next = open[slot];
+        const int parity = length & 1;
+        const int first = visits[2 * next + parity];
+
+        open[slot] = -1;
+        link(open, next, node, -1);
+
+        if (first == -1) {
+            visits[2 * next + parity] = length;
+            trail[length++] = next;
+            continue;
+        }
+
+        // Store the AB-cycle so that it starts with an A-edge
+
+        const int base = cycleStarts[cycles];
+        const int total = length - first;
+
+        for (int i = 0; i < total; i++)
+            cycleNodes[base + i] = trail[first + (i + (first & 1)) % total];
+
+        for (int i = first + 1; i < length; i++)
+            visits[2 * trail[i] + (i & 1)] = -1;
+
+        cycleStarts[++cycles] = base + total;
+        length = first + 1;
+    }
+
+    visits[2 * start] = -1;
+}
+
+//------------------------------------------------------------------------------
+// Replace the A-edges of an AB-cycle with its B-edges in the current child
+
+float Eax::apply(int cycle)
+{
+    const int *nodes = cycleNodes + cycleStarts[cycle];
+    const int length = cycleStarts[cycle + 1] - cycleStarts[cycle];
+    float gain = 0.0;
+
+    for (int i = 0; i < length; i += 2) {
+        link(adjacent, nodes[i], nodes[i + 1], -1);
+        link(adjacent, nodes[i + 1], nodes[i], -1);
+        gain -= instance->distance(nodes[i], nodes[i + 1]);
+    }
+
+    for (int i = 1; i < length; i += 2) {
+        const int next = nodes[(i + 1) % length];
+        link(adjacent, nodes[i], -1, next);
+        link(adjacent, next, -1, nodes[i]);
+        gain += instance->distance(nodes[i], next);
+    }
+
+    return gain;
+}
+
+//------------------------------------------------------------------------------
+// Build a child from the father and the AB-cycles chosen around one of them
+
+float Eax::assemble(int center, Strategy strategy)
+{
+    float gain;
+
+    memcpy(adjacent, adjacentA, sizeof(int) * 2 * size);
+    gain = apply(center);
+
+    if (strategy == Block) {
+        const unsigned int mark = nextStamp();
+
+        for (int i = cycleStarts[center]; i < cycleStarts[center + 1]; i++)
+            stamps[cycleNodes[i]] = mark;
+
+        for (int j = 0; j < cycles; j++) {
+            if (j == center)
+                continue;
+
+            for (int i = cycleStarts[j]; i < cycleStarts[j + 1]; i++) {
+                if (stamps[cycleNodes[i]] == mark) {
+                    gain += apply(j);
+                    break;
+                }
+            }
+        }
+    }
+
+    return gain + repair();
+}
+
+//------------------------------------------------------------------------------
+// Join the subtours of the current child, the smallest one first
+
+float Eax::repair()
+{
+    float gain = 0.0;
+    int remaining = label();
+    Move move;
+
+    while (remaining > 1) {
+        int smallest = 0;
+
+        for (int i = 1; i < remaining; i++)
+            if (subtourSizes[alive[i]] < subtourSizes[alive[smallest]])
+                smallest = i;
+
+        const int subtour = alive[smallest];
+        int node = subtourNodes[subtour];
+        int previous = -1;
+
+        move.gain = FLT_MAX;
+
+        for (int i = 0; i < subtourSizes[subtour]; i++) {
+            const int *row = neighbors + (size_t)node * count;
+
+            for (int side = 0; side < 2; side++)
+                for (int j = 0; j < count; j++)
+                    if (subtours[row[j]] != subtour)
+                        consider(node, adjacent[2 * node + side], row[j], move);
+
+            const int next = walk(adjacent, node, previous);
+            previous = node;
+            node = next;
+        }
+
+        // No candidate lies outside the subtour: try every other node
+
+        if (move.gain == FLT_MAX) {
+            node = subtourNodes[subtour];
+
+            for (int j = 0; j < size; j++)
+                if (subtours[j] != subtour)
+                    consider(node, adjacent[2 * node], j, move);
+        }
+
+        const int target = subtours[move.other];
+
+        node = subtourNodes[subtour];
+        previous = -1;
+
+        for (int i = 0; i < subtourSizes[subtour]; i++) {
+            const int next = walk(adjacent, node, previous);
+            subtours[node] = target;
+            previous = node;
+            node = next;
+        }
+
+        const int joinOther = move.crossed ? move.mate : move.other;
+        const int joinMate = move.crossed ? move.other : move.mate;
+
+        link(adjacent, move.node, move.next, joinOther);
+        link(adjacent, move.next, move.node, joinMate);
+        link(adjacent, joinOther, move.crossed ? move.other : move.mate, move.node);
+        link(adjacent, joinMate, move.crossed ? move.mate : move.other, move.next);
+
+        subtourSizes[target] += subtourSizes[subtour];
+        alive[smallest] = alive[--remaining];
+        gain += move.gain;
+    }
+
+    return gain;
+}
+
+//------------------------------------------------------------------------------
+// Evaluate the 2-opt moves that replace the edge (node, next) of a subtour and
+// an edge of other with two edges between both subtours.
+
+void Eax::consider(int node, int next, int other, Move &move) const
+{
+    const float removed = instance->distance(node, next);
+
+    for (int side = 0; side < 2; side++) {
+        const int mate = adjacent[2 * other + side];
+        const float base = removed + instance->distance(other, mate);
+        const float straight = instance->distance(node, other) + instance->distance(next, mate) - base;
+        const float crossed = instance->distance(node, mate) + instance->distance(next, other) - base;
+
+        if (straight < move.gain) {
+            move.gain = straight;
+            move.node = node;
+            move.next = next;
+            move.other = other;
+            move.mate = mate;
+            move.crossed = false;
+        }
+
+        if (crossed < move.gain) {
+            move.gain = crossed;
+            move.node = node;
+            move.next = next;
+            move.other = other;
+            move.mate = mate;
+            move.crossed = true;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Number the subtours of the current child
+
+int Eax::label()
+{
+    int total = 0;
+
+    for (int i = 0; i < size; i++)
+        subtours[i] = -1;
+
+    for (int i = 0; i < size; i++) {
+        if (subtours[i] != -1)
+            continue;
+
+        int node = i, previous = -1, length = 0;
+
+        do {
+            const int next = walk(adjacent, node, previous);
+            subtours[node] = total;
+            previous = node;
+            node = next;
+            length++;
+        } while (node != i);
+
+        subtourSizes[total] = length;
+        subtourNodes[total] = i;
+        alive[total] = total;
+        total++;
+    }
+
+    return total;
+}
+
+//------------------------------------------------------------------------------
+// Next node along a cycle of an adjacency table
+
+int Eax::walk(const int *table, int node, int previous)
+{
+    return table[2 * node] != previous ? table[2 * node] : table[2 * node + 1];
+}
+
+//------------------------------------------------------------------------------
+// Mark that identifies the nodes of the current block
+
+unsigned int Eax::nextStamp()
+{
+    if (++stamp == 0) {
+        memset(stamps, 0, sizeof(unsigned int) * size);
+        stamp = 1;
+    }
+
+    return stamp;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file eax.h
+ * @brief Declaration of the Eax class
+ * @date October 18, 2026
+ */
+
+#ifndef EAX_H
+#define EAX_H
+
+#include "cycle.h"
+
+#define EAX_CHILDREN 10     ///< Children evaluated by each crossover
+
+/**
+ * @brief Edge assembly crossover
+ *
+ * The edges of both parents form AB-cycles: closed paths that alternate an
+ * edge of the father (A) and an edge of the mother (B) not shared by both. A
+ * child is the father with the A-edges of some AB-cycles replaced by their
+ * B-edges, which leaves a set of subtours. They are joined greedily, merging
+ * the smallest subtour at each step with the 2-opt move of least cost among
+ * the candidate lists of its nodes.
+ *
+ * Several children are built from different AB-cycles and only the best is
+ * kept. All the buffers are allocated by the constructor, so a crossover does
+ * not allocate any memory.
+ */
+class Eax
+{
+public:
+
+    /// Choice of the AB-cycles of a child
+    enum Strategy {
+        Single, ///< One AB-cycle (EAX-1AB)
+        Block   ///< One AB-cycle and every AB-cycle that shares a node with it
+    };
+
+    /**
+     * @brief Constructor
+     * @param sample Cycle over the instance of the parents.
+     */
+    explicit Eax(const Cycle &sample);
+
+    /// Destructor
+    ~Eax();
+
+    /**
+     * @brief Cross two tours
+     * @param father Parent that the child is based on (A).
+     * @param mother Parent that the new edges come from (B).
+     * @param child Destination tour, with its cost updated.
+     * @param strategy Choice of the AB-cycles.
+     * @param generator Random number generator.
+     */
+    void cross(const Cycle &father, const Cycle &mother, Cycle &child, Strategy strategy, Algorithms::Generator &generator);
+
+private:
+
+    /// 2-opt move that joins two subtours
+    struct Move {
+        float gain;     ///< Change of cost
+        int node;       ///< Node of the subtour being merged
+        int next;       ///< Neighbor of node in its subtour
+        int other;      ///< Node of another subtour
+        int mate;       ///< Neighbor of other in its subtour
+        bool crossed;   ///< Whether node is joined to mate instead of other
+    };
+
+    int size;               ///< Number of nodes
+    std::shared_ptr<const Instance> instance;   ///< Distances and candidates
+    const int *neighbors;   ///< Candidate lists of the instance
+    int count;              ///< Length of each candidate list
+    int *adjacentA;         ///< Neighbors of each node in the father
+    int *adjacentB;         ///< Neighbors of each node in the mother
+    int *openA;             ///< Father edges not yet in an AB-cycle (-1 if none)
+    int *openB;             ///< Mother edges not yet in an AB-cycle (-1 if none)
+    int *trail;             ///< Alternating walk being traced
+    int *visits;            ///< Position of each node in the walk, by parity
+    int *cycleNodes;        ///< Nodes of all the AB-cycles, back to back
+    int *cycleStarts;       ///< Offset of each AB-cycle in cycleNodes
+    int cycles;             ///< Number of AB-cycles
+    int *order;             ///< AB-cycles in random order
+    int *adjacent;          ///< Neighbors of each node in the current child
+    int *best;              ///< Neighbors of each node in the best child
+    int *subtours;          ///< Subtour of each node
+    int *subtourSizes;      ///< Number of nodes of each subtour
+    int *subtourNodes;      ///< One node of each subtour
+    int *alive;             ///< Subtours not merged yet
+    unsigned int *stamps;   ///< Mark of each node in a block
+    unsigned int stamp;     ///< Mark of the current block
+
+    Eax(const Eax &);
+    Eax & operator=(const Eax &);
+
+    static void link(int *table, int node, int from, int to);
+    void build(const Cycle &tour, int *table);
+    void trace(int start, Algorithms::Generator &generator);
+    float apply(int cycle);
+    float assemble(int center, Strategy strategy);
+    float repair();
+    void consider(int node, int next, int other, Move &move) const;
+    int label();
+    static int walk(const int *table, int node, int previous);
+    unsigned int nextStamp();
+};
+
+#endif /* EAX_H */
@@ -0,0 +1,131 @@
+/**
+ * @file generator.h
+ * @brief Declaration of the pseudorandom number generator
+ * @date October 18, 2026
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstdint>
+
+/**
+ * @brief xoshiro256** generator
+ *
+ * Small and fast generator of 64-bit numbers by Blackman and Vigna, with a
+ * state of four words. It meets the requirements of a uniform random bit
+ * generator, so it can be used with the distributions of <random>.
+ *
+ * Independent streams are drawn from a single seed by jumping ahead: stream
+ * @c k starts 2^128 * k numbers after the start of the seed, so streams never
+ * overlap and each one only depends on the seed and its own number.
+ */
+class Xoshiro256
+{
+public:
+    typedef uint64_t result_type;
+
+    /**
+     * @brief Constructor
+     * @param seed Seed of the sequence.
+     */
+    explicit Xoshiro256(uint64_t seed = 0)
+    {
+        this->seed(seed);
+    }
+
+    /**
+     * @brief Constructor of a stream
+     * @param seed Seed of the sequence.
+     * @param stream Number of the stream.
+     */
+    Xoshiro256(uint64_t seed, uint64_t stream)
+    {
+        this->seed(seed);
+
+        for (uint64_t i = 0; i < stream; i++)
+            jump();
+    }
+
+    /**
+     * @brief Restart the sequence
+     * @param value Seed of the sequence.
+     *
+     * The state is filled with SplitMix64, so that close seeds give unrelated
+     * sequences and the state is never all zeros.
+     */
+    void seed(uint64_t value)
+    {
+        for (int i = 0; i < 4; i++) {
+            uint64_t z = (value += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    /// Advance the sequence 2^128 numbers
+    void jump()
+    {
+        static const uint64_t polynomial[4] = {
+            0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+            0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+        };
+        uint64_t jumped[4] = { 0, 0, 0, 0 };
+
+        for (int i = 0; i < 4; i++) {
+            for (int b = 0; b < 64; b++) {
+                if (polynomial[i] & (1ULL << b))
+                    for (int j = 0; j < 4; j++)
+                        jumped[j] ^= state[j];
+
+                (*this)();
+            }
+        }
+
+        for (int j = 0; j < 4; j++)
+            state[j] = jumped[j];
+    }
+
+    /// Next number of the sequence
+    inline result_type operator ()()
+    {
+        const uint64_t result = rotate(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+
+        return result;
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return UINT64_MAX;
+    }
+
+private:
+    uint64_t state[4];  ///< State of the generator
+
+    static inline uint64_t rotate(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+namespace Algorithms
+{
+/// Generator used by every algorithm
+typedef Xoshiro256 Generator;
+}
+
+#endif /* GENERATOR_H */
@@ -2,23 +2,56 @@
 
 #include "population.h"
 #include <iostream>
+#include "checkpoint.h"
 
 using namespace std;
 
 namespace Algorithms
 {
 
-void genetic(Cycle &data, int size, int count, Scheme scheme, unsigned int seed)
+/**
+ * @brief Save the state of the genetic algorithm
+ * @param checkpoint Destination.
+ * @param data Best cycle.
+ * @param population Population.
+ * @param generator Random stream.
+ * @param i Evaluations done.
+ */
+static void save(Checkpoint &checkpoint, const Cycle &data, const Population &population, const Generator &generator, int i)
+{
+    checkpoint.begin(data);
+    checkpoint.put(i);
+    checkpoint.put(generator);
+    checkpoint.put(data);
+    population.save(checkpoint);
+    checkpoint.commit();
+}
+
+void genetic(Cycle &data, int size, int count, Scheme scheme, Crossover crossover, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint)
 {
     const int nMax = count * data.getSize();
     int iBest;
+    int i = 0;
     Cycle &bestCycle = data;
-    mt19937 generator(seed);
-    Population population(size, data, generator);
+    Generator generator(seed);
+    Population population(size, data, generator, crossover);
+
+    if (warm)
+        population.inject(data);
 
     data.setPath(population[population.bestCycle()]);
 
-    for (int i = 0; i < nMax; i += (scheme == Generational ? size : 2)) {
+    if (checkpoint != NULL && checkpoint->restore()) {
+        checkpoint->get(i);
+        checkpoint->get(generator);
+        checkpoint->get(data);
+        population.load(*checkpoint);
+    }
+
+    for (; i < nMax && !deadline.expired(); i += (scheme == Generational ? size : 2)) {
+        if (checkpoint != NULL && checkpoint->due())
+            save(*checkpoint, data, population, generator, i);
+
         population.evolve(scheme);
         iBest = population.bestCycle();
 
@@ -26,9 +59,14 @@ void genetic(Cycle &data, int size, int count, Scheme scheme, unsigned int seed)
             bestCycle.setPath(population[iBest]);
 
 #ifdef PROFILE
-        cout << i << " / " << nMax << ": " << bestCycle.getCost() << endl;
+        cout << i << " / " << nMax << ": " << bestCycle.getCost() << " (duplicates: " << population.duplicateRate() * 100 << "%)" << endl;
 #endif
     }
+
+    // Generations are never cut short, so the last state is always whole
+
+    if (checkpoint != NULL)
+        save(*checkpoint, data, population, generator, i);
 }
 
 }
@@ -4,27 +4,72 @@
 #include <cfloat>
 #include <iostream>
 #include "population.h"
+#include "checkpoint.h"
 
 using namespace std;
 
 namespace Algorithms
 {
 
-void parallelGenetic(Cycle &data, int processes, int size, int count, int migrLatency, Topology topology, unsigned int seed)
+/**
+ * @brief Save the state of the parallel genetic algorithm
+ * @param checkpoint Destination.
+ * @param data Best cycle.
+ * @param world Population of each island.
+ * @param streams Random stream of each island.
+ * @param processes Number of islands.
+ * @param n Generations done.
+ */
+static void save(Checkpoint &checkpoint, const Cycle &data, const Population *world, const Generator *streams, int processes, int n)
+{
+    checkpoint.begin(data);
+    checkpoint.put(n);
+    checkpoint.put(data);
+
+    for (int i = 0; i < processes; i++) {
+        checkpoint.put(streams[i]);
+        world[i].save(checkpoint);
+    }
+
+    checkpoint.commit();
+}
+
+void parallelGenetic(Cycle &data, int processes, int size, int count, int migrLatency, Topology topology, Crossover crossover, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint)
 {
     const int nMax = count * data.getSize();
-    int iBest;
+    int iBest = 0;
+    int n = 0;
     float bestMean;
-    std::mt19937 generator(seed);
     Cycle &bestCycle = data;
+    Generator *streams = new Generator[processes];
     Population *world = new Population[processes];
 
-    for (int i = 0; i < processes; i++)
-        world[i] = Population(size, data, generator);
+    // Each island draws from its own stream of the seed
+
+    for (int i = 0; i < processes; i++) {
+        streams[i] = Generator(seed, i);
+        world[i] = Population(size, data, streams[i], crossover);
+
+        if (warm)
+            world[i].inject(data);
+    }
 
     migrLatency *= data.getSize();
 
-    for (int n = 0; n < nMax; n++) {
+    if (checkpoint != NULL && checkpoint->restore()) {
+        checkpoint->get(n);
+        checkpoint->get(data);
+
+        for (int i = 0; i < processes; i++) {
+            checkpoint->get(streams[i]);
+            world[i].load(*checkpoint);
+        }
+    }
+
+    for (; n < nMax && !deadline.expired(); n++) {
+        if (checkpoint != NULL && checkpoint->due())
+            save(*checkpoint, data, world, streams, processes, n);
+
         for (int i = 0; i < processes; i++)
             world[i].evolve(Generational);
 
@@ -44,8 +89,8 @@ void parallelGenetic(Cycle &data, int processes, int size, int count, int migrLa
 
                 for (int i = 0; i < processes; i++) {
                     if (i != iBest) {
-                        world[i][world[i].worstCycle()].setPath(world[iBest][world[iBest].bestCycle()]);
-                        world[iBest][world[iBest].worstCycle()].setPath(world[i][world[i].bestCycle()]);
+                        world[i].setPath(world[i].worstCycle(), world[iBest][world[iBest].bestCycle()]);
+                        world[iBest].setPath(world[iBest].worstCycle(), world[i][world[i].bestCycle()]);
                     }
                 }
 
@@ -53,7 +98,7 @@ void parallelGenetic(Cycle &data, int processes, int size, int count, int migrLa
 
             case Ring:
                 for (int i = 0; i < processes; i++)
-                    world[i][world[i].worstCycle()].setPath(world[(i + 1) % processes][world[(i + 1) % processes].bestCycle()]);
+                    world[i].setPath(world[i].worstCycle(), world[(i + 1) % processes][world[(i + 1) % processes].bestCycle()]);
             }
         }
 
@@ -68,6 +113,12 @@ void parallelGenetic(Cycle &data, int processes, int size, int count, int migrLa
         cout << n << " / " << nMax << ": " << bestCycle.getCost() << endl;
 #endif
     }
+
+    if (checkpoint != NULL)
+        save(*checkpoint, data, world, streams, processes, n);
+
+    delete [] world;
+    delete [] streams;
 }
 
 }
@@ -34,7 +34,7 @@ void bubblesort(Cycle &data, int ilast, int lsize)
     }
 }
 
-void greedyProb(Cycle &data, std::mt19937 &generator)
+void greedyProb(Cycle &data, Generator &generator)
 {
     const int lsize = data.getSize() / 10;
     int ilast = 0;
@@ -61,42 +61,48 @@ void greedyProb(Cycle &data, std::mt19937 &generator)
     }
 }
 
-void grasp(Cycle &data, int count, unsigned int seed)
+void grasp(Cycle &data, int count, unsigned int seed, Deadline &deadline)
 {
     Cycle &bestCycle = data;
     Cycle curCycle = data;
-    std::mt19937 generator(seed);
+    Generator generator(seed);
 
     bestCycle.clearPath();
 
     for (int k = 0; k < count; k++) {
         greedyProb(curCycle, generator);
-        localSearch(curCycle);
+        localSearch(curCycle, deadline);
 
         if (curCycle.getCost() < bestCycle.getCost())
             bestCycle.setPath(curCycle);
+
+        if (deadline.expired())
+            break;
     }
 }
 
-void graspExt(Cycle &data, int count, unsigned int seed)
+void graspExt(Cycle &data, int count, unsigned int seed, Deadline &deadline)
 {
     const int s = data.getSize() / 4;
     Cycle &bestCycle = data;
     Cycle curCycle = data;
-    std::mt19937 generator(seed);
+    Generator generator(seed);
 
     bestCycle.clearPath();
 
     for (int k = 0; k < count; k++) {
         greedyProb(curCycle, generator);
-        localSearch(curCycle);
+        localSearch(curCycle, deadline);
 
         for (int m = 0; m < NMUT; m++) {
             curCycle.shuffleSubpath(s, generator);
-            localSearch(curCycle);
+            localSearch(curCycle, deadline);
 
             if (bestCycle.getCost() > curCycle.getCost())
                 bestCycle.setPath(curCycle);
+
+            if (deadline.expired())
+                return;
         }
     }
 }
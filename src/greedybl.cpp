@@ -6,16 +6,16 @@
 namespace Algorithms
 {
 
-void greedy_bl(Cycle &data)
+void greedy_bl(Cycle &data, Deadline &deadline)
 {
     greedy(data);
-    localSearch(data);
+    localSearch(data, deadline);
 }
 
-void greedy_blext(Cycle &data, int count, unsigned int seed)
+void greedy_blext(Cycle &data, int count, unsigned int seed, Deadline &deadline)
 {
     const int s = data.getSize() / 4;
-    std::mt19937 generator(seed);
+    Generator generator(seed);
     Cycle greedyCycle = data;
     Cycle curCycle = data;
     Cycle &bestCycle = data;
@@ -26,10 +26,13 @@ void greedy_blext(Cycle &data, int count, unsigned int seed)
     for (int k = 0; k < count; k++) {
         curCycle.setPath(greedyCycle);
         curCycle.shuffleSubpath(s, generator);
-        localSearch(curCycle);
+        localSearch(curCycle, deadline);
 
         if (curCycle.getCost() < bestCycle.getCost())
             bestCycle.setPath(curCycle);
+
+        if (deadline.expired())
+            break;
     }
 }
 
@@ -6,20 +6,27 @@
 namespace Algorithms
 {
 
-void iteratedLocalSearch(Cycle &data, int count, unsigned int seed)
+void iteratedLocalSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline)
+{
+    Generator generator(seed);
+
+    data.shufflePath(generator);
+    iteratedLocalSearch(data, count, generator, deadline);
+}
+
+void iteratedLocalSearch(Cycle &data, int count, Generator &generator, Deadline &deadline)
 {
     const int s = data.getSize() / 4;
     Cycle &bestCycle = data;
     Cycle curCycle = data;
-    std::mt19937 generator(seed);
 
-    // This overload initializes randomly
-    localSearch(bestCycle, generator);
+    // Start from the tour given in data
+    localSearch(bestCycle, deadline);
 
-    for (int k = 1; k < count; k++) {
+    for (int k = 1; k < count && !deadline.expired(); k++) {
         curCycle.setPath(bestCycle);
         curCycle.shuffleSubpath(s, generator);
-        localSearch(curCycle);
+        localSearch(curCycle, deadline);
 
         if (curCycle.getCost() < bestCycle.getCost())
             bestCycle.setPath(curCycle);
@@ -0,0 +1,1336 @@
+/**
+ * @file instance.cpp
+ * @brief Definition of the Instance class
+ * @date October 18, 2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "instance.h"
+#include "allocator.h"
+#include "reader.h"
+
+/// Header of a compiled instance
+struct BinaryHeader {
+    char magic[8];          ///< BINARY_MAGIC
+    uint32_t version;       ///< BINARY_VERSION
+    uint32_t layout;        ///< Layout of the distance matrix
+    uint32_t metric;        ///< Edge weight type
+    int32_t size;           ///< Number of nodes
+    int32_t neighbors;      ///< Length of each candidate list
+    uint32_t weight;        ///< Type of the matrix cells
+    uint64_t hash;          ///< Content hash
+    uint64_t vertices;      ///< Offset of the coordinates
+    uint64_t ids;           ///< Offset of the original numbers (0 if none)
+    uint64_t distances;     ///< Offset of the distance matrix
+    uint64_t candidates;    ///< Offset of the candidate lists (0 if none)
+    uint64_t length;        ///< Length of the file
+};
+
+/// Order of the cells in an EDGE_WEIGHT_SECTION
+enum WeightFormat {
+    NoFormat,       ///< Not given
+    FullMatrix,     ///< Every row, complete
+    UpperRow,       ///< Upper triangle, row by row, without diagonal
+    LowerRow,       ///< Lower triangle, row by row, without diagonal
+    UpperDiagRow,   ///< Upper triangle, row by row, with diagonal
+    LowerDiagRow    ///< Lower triangle, row by row, with diagonal
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Parse the name of an edge weight type
+ * @param name Value of EDGE_WEIGHT_TYPE.
+ * @param metric Destination of the metric.
+ * @return Whether the type is supported.
+ */
+static bool parseMetric(const std::string &name, Instance::Metric &metric)
+{
+    if (name == "EUC_2D")
+        metric = Instance::Euc2D;
+    else if (name == "CEIL_2D")
+        metric = Instance::Ceil2D;
+    else if (name == "ATT")
+        metric = Instance::Att;
+    else if (name == "GEO")
+        metric = Instance::Geo;
+    else if (name == "EXPLICIT")
+        metric = Instance::Explicit;
+    else
+        return false;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Parse the name of an edge weight format
+ * @param name Value of EDGE_WEIGHT_FORMAT.
+ * @param format Destination of the format.
+ * @return Whether the format is supported.
+ */
+static bool parseFormat(const std::string &name, WeightFormat &format)
+{
+    if (name == "FULL_MATRIX")
+        format = FullMatrix;
+    else if (name == "UPPER_ROW")
+        format = UpperRow;
+    else if (name == "LOWER_ROW")
+        format = LowerRow;
+    else if (name == "UPPER_DIAG_ROW")
+        format = UpperDiagRow;
+    else if (name == "LOWER_DIAG_ROW")
+        format = LowerDiagRow;
+    else
+        return false;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Read a NODE_COORD_SECTION or a DISPLAY_DATA_SECTION
+ * @param reader Reader placed after the name of the section.
+ * @param points Destination of the coordinates (one per node).
+ *
+ * Each line holds the number of a node and its coordinates. Nodes may come in
+ * any order.
+ *
+ * @return Whether every line was valid.
+ */
+static bool readCoordinates(Reader &reader, std::vector<Instance::Vertex> &points)
+{
+    const int size = points.size();
+    double id, x, y;
+
+    for (int i = 0; i < size; i++) {
+        if (!reader.number(id) || !reader.number(x) || !reader.number(y) || id < 1 || id > size)
+            return false;
+
+        points[(int)id - 1].x = x;
+        points[(int)id - 1].y = y;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Read an EDGE_WEIGHT_SECTION
+ * @param reader Reader placed after the name of the section.
+ * @param matrix Destination matrix.
+ * @param size Number of nodes.
+ * @param layout Layout of the matrix.
+ * @param format Order of the cells in the section.
+ * @return Whether every cell was read.
+ */
+static bool readWeights(Reader &reader, float *matrix, int size, Instance::Layout layout, WeightFormat format)
+{
+    double weight;
+
+    for (int i = 0; i < size; i++) {
+        int first = 0, last = size;
+
+        switch (format) {
+        case UpperRow:
+            first = i + 1;
+            break;
+        case UpperDiagRow:
+            first = i;
+            break;
+        case LowerRow:
+            last = i;
+            break;
+        case LowerDiagRow:
+            last = i + 1;
+            break;
+        default:
+            break;
+        }
+
+        for (int j = first; j < last; j++) {
+            if (!reader.number(weight))
+                return false;
+
+            matrix[Instance::cellIndex(i, j, size, layout)] = weight;
+            matrix[Instance::cellIndex(j, i, size, layout)] = weight;
+        }
+
+        matrix[Instance::cellIndex(i, i, size, layout)] = 0.0;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Latitude or longitude of a GEO coordinate
+ * @param value Coordinate as DDD.MM (degrees and minutes).
+ * @return Angle in radians, as defined by TSPLIB.
+ */
+static inline double geoRadians(float value)
+{
+    const int degrees = (int)value;
+
+    return 3.141592 * (degrees + 5.0 * (value - degrees) / 3.0) / 180.0;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Distance between two nodes
+ * @param metric Edge weight type.
+ * @param a One of the nodes.
+ * @param b The other node.
+ * @pre @p metric must not be Explicit.
+ * @return Distance rounded as defined by TSPLIB (EUC_2D is truncated).
+ */
+static inline float measure(Instance::Metric metric, const Instance::Vertex &a, const Instance::Vertex &b)
+{
+    register float x = a.x - b.x;
+    register float y = a.y - b.y;
+
+    switch (metric) {
+    case Instance::Ceil2D:
+        return ceil(sqrt((double)x * x + (double)y * y));
+
+    case Instance::Att: {
+        const double r = sqrt(((double)x * x + (double)y * y) / 10.0);
+        const double t = (int)(r + 0.5);
+
+        return t < r ? t + 1 : t;
+    }
+
+    case Instance::Geo: {
+        const double q1 = cos(geoRadians(a.y) - geoRadians(b.y));
+        const double q2 = cos(geoRadians(a.x) - geoRadians(b.x));
+        const double q3 = cos(geoRadians(a.x) + geoRadians(b.x));
+
+        return (int)(6378.388 * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+
+    default:
+        return floor(sqrt(x * x + y * y));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Distance between two nodes, as the full matrix computes it
+ * @param metric Edge weight type.
+ * @param vertices Nodes of the instance.
+ * @param i Index of one of the nodes.
+ * @param j Index of the other node.
+ * @return Distance from the node of greater index to the other one.
+ */
+static inline float measure(Instance::Metric metric, const Instance::Vertex *vertices, int i, int j)
+{
+    return i > j ? measure(metric, vertices[i], vertices[j]) : measure(metric, vertices[j], vertices[i]);
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Add bytes to a 64-bit FNV-1a hash
+ * @param hash Current value of the hash.
+ * @param data Bytes to add.
+ * @param length Number of bytes.
+ * @return New value of the hash.
+ */
+static uint64_t fnv(uint64_t hash, const void *data, size_t length)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+// Default constructor
+
+Instance::Instance()
+{
+    size = 0;
+    capacity = 0;
+    layout = Packed;
+    metric = Euc2D;
+    vertices = NULL;
+    ids = NULL;
+    distances = NULL;
+    candidates = NULL;
+    weight = Float32;
+    hashed = false;
+    mapping = NULL;
+    mappingSize = 0;
+}
+
+//------------------------------------------------------------------------------
+// Constructor with assigned size
+
+Instance::Instance(int size)
+{
+    this->size = size;
+    this->capacity = size;
+    this->layout = Packed;
+    this->metric = Euc2D;
+    this->vertices = Allocator::allocate<Vertex>(size, true);
+    this->ids = NULL;
+    this->distances = Allocator::allocate<float>(matrixCells(size, layout), true);
+    this->candidates = NULL;
+    this->mapping = NULL;
+    this->mappingSize = 0;
+    this->weight = Float32;
+    this->hashed = false;
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+
+Instance::~Instance()
+{
+    unmap();
+    Allocator::release(vertices);
+    Allocator::release(ids);
+    Allocator::release(distances);
+    Allocator::release(candidates);
+}
+
+//------------------------------------------------------------------------------
+// Load nodes from a TSP file
+
+bool Instance::loadTsp(const char *path, Layout layout, Order order)
+{
+    using namespace std;
+    Reader reader;
+    string key, value;
+    vector<Vertex> points;
+    float *matrix = NULL;
+    int newSize = 0;
+    Metric newMetric = Euc2D;
+    WeightFormat format = NoFormat;
+    bool typed = false, located = false, valid = true;
+
+    if (!reader.open(path)) {
+        cerr << "Could not open file " << path << endl;
+        return false;
+    }
+
+    if (reader.startsWith(BINARY_MAGIC, sizeof(BinaryHeader::magic)))
+        return loadBinary(path);
+
+    /*
+     * Keywords may come in any order, but a section needs the dimension (and
+     * the weight format) to have been given before it.
+     */
+
+    while (valid && reader.keyword(key, value)) {
+        if (key == "EOF")
+            break;
+        else if (key == "TYPE") {
+            if (value != "TSP") {
+                cerr << "Read error: Expected <TYPE==TSP> and got <" << value << ">\n";
+                valid = false;
+            }
+        } else if (key == "DIMENSION") {
+            newSize = atoi(value.c_str());
+            points.assign(newSize > 0 ? newSize : 0, Vertex());
+
+            if (newSize <= 0) {
+                cerr << "Read error: dimension not recognized.\n";
+                valid = false;
+            }
+        } else if (key == "EDGE_WEIGHT_TYPE") {
+            if (!(typed = parseMetric(value, newMetric))) {
+                cerr << "Read error: edge weight type <" << value << "> not supported.\n";
+                valid = false;
+            }
+        } else if (key == "EDGE_WEIGHT_FORMAT") {
+            if (!parseFormat(value, format)) {
+                cerr << "Read error: edge weight format <" << value << "> not supported.\n";
+                valid = false;
+            }
+        } else if (key == "NODE_COORD_SECTION" || (key == "DISPLAY_DATA_SECTION" && newMetric == Explicit)) {
+            if (!(valid = newSize > 0 && readCoordinates(reader, points)))
+                cerr << "Read error: invalid or missing nodes in " << key << ".\n";
+
+            located = true;
+        } else if (key == "EDGE_WEIGHT_SECTION") {
+            if (newSize <= 0 || format == NoFormat) {
+                cerr << "Read error: EDGE_WEIGHT_SECTION before DIMENSION or EDGE_WEIGHT_FORMAT.\n";
+                valid = false;
+                break;
+            }
+
+            Allocator::release(matrix);
+            matrix = Allocator::allocate<float>(matrixCells(newSize, layout));
+
+            if (!(valid = readWeights(reader, matrix, newSize, layout, format)))
+                cerr << "Read error: missing weights in EDGE_WEIGHT_SECTION.\n";
+        } else if (value.empty()) {
+            // Unknown section: skip its numbers
+
+            double skipped;
+
+            while (reader.number(skipped))
+                ;
+        }
+    }
+
+    if (valid && !typed) {
+        cerr << "Reading error: label <EDGE_WEIGHT_TYPE> not found.\n";
+        valid = false;
+    } else if (valid && newSize <= 0) {
+        cerr << "Reading error: label <DIMENSION> not found.\n";
+        valid = false;
+    } else if (valid && (newMetric == Explicit ? matrix == NULL : !located)) {
+        cerr << "Read error: no " << (newMetric == Explicit ? "EDGE_WEIGHT" : "NODE_COORD") << "_SECTION found.\n";
+        valid = false;
+    }
+
+    if (!valid) {
+        Allocator::release(matrix);
+        return false;
+    }
+
+    unmap();
+    vertices = Allocator::reallocate(vertices, newSize);
+    memcpy(vertices, points.data(), sizeof(Vertex) * newSize);
+
+    if (matrix != NULL) {
+        Allocator::release(distances);
+        distances = matrix;
+    } else
+        distances = Allocator::reallocate(distances, matrixCells(newSize, layout));
+
+    size = newSize;
+    this->layout = layout;
+    metric = newMetric;
+    weight = Float32;
+    prepare(order);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Load nodes from memory
+
+bool Instance::loadVertices(const Vertex *vertices, int size, Layout layout, Order order)
+{
+    if (size <= 0) {
+        std::cerr << "Read error: no nodes given.\n";
+        return false;
+    }
+
+    unmap();
+    this->vertices = Allocator::reallocate(this->vertices, size);
+    distances = Allocator::reallocate(distances, matrixCells(size, layout));
+    memcpy(this->vertices, vertices, sizeof(Vertex) * size);
+
+    this->size = size;
+    this->layout = layout;
+    metric = Euc2D;
+    weight = Float32;
+    prepare(order);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Add a node
+
+int Instance::addVertex(const Vertex &vertex)
+{
+    const int count = getNeighbors();
+    const int node = size;
+
+    if (!editable())
+        return -1;
+
+    // Buffers grow by an eighth, so that a stream of additions seldom moves them
+
+    if (size + 1 > capacity)
+        capacity = size + 1 + size / 8 + 16;
+
+    vertices = Allocator::reallocate(vertices, capacity);
+    distances = Allocator::reallocate(distances, matrixCells(capacity, layout));
+    vertices[node] = vertex;
+
+    if (ids != NULL) {
+        ids = Allocator::reallocate(ids, capacity);
+        ids[node] = node;
+    }
+
+    size++;
+    hashed = false;
+
+    // Rows of the packed matrix do not depend on the size: the new one is last
+
+    if (layout == Packed)
+        updateDistances(node);
+    else
+        updateDistances();
+
+    if (candidates == NULL)
+        return node;
+
+    if (getNeighbors() != count) {
+        Allocator::release(candidates);
+        candidates = NULL;
+        return node;
+    }
+
+    candidates = Allocator::reallocate(candidates, (size_t)capacity * count + 1);
+
+    for (int i = 0; i < node; i++)
+        offerNeighbor(i, node);
+
+    buildNeighbors(node, candidates + (size_t)node * count, true);
+    return node;
+}
+
+//------------------------------------------------------------------------------
+// Remove a node
+
+bool Instance::removeVertex(int node)
+{
+    const int last = size - 1;
+    const int count = getNeighbors();
+    std::vector<int> stale;
+
+    if (node < 0 || node >= size || size == 1 || !editable())
+        return false;
+
+    // Lists that hold either node are built again once the indices are final
+
+    if (candidates != NULL) {
+        for (int i = 0; i < size; i++) {
+            const int *row = candidates + (size_t)i * count;
+
+            if (i == node)
+                continue;
+
+            for (int k = 0; k < count; k++) {
+                if (row[k] == node || row[k] == last) {
+                    stale.push_back(i == last ? node : i);
+                    break;
+                }
+            }
+        }
+    }
+
+    if (ids == NULL && node != last) {
+        ids = Allocator::allocate<int>(std::max(capacity, size));
+
+        for (int i = 0; i < size; i++)
+            ids[i] = i;
+    }
+
+    if (ids != NULL) {
+        const int id = ids[node];
+        ids[node] = ids[last];
+
+        for (int i = 0; i < last; i++) {
+            if (ids[i] > id)
+                ids[i]--;
+        }
+    }
+
+    vertices[node] = vertices[last];
+    size--;
+    hashed = false;
+
+    if (layout != Packed)
+        updateDistances();
+    else if (node != last)
+        updateDistances(node);
+
+    if (candidates == NULL)
+        return true;
+
+    if (getNeighbors() != count) {
+        Allocator::release(candidates);
+        candidates = NULL;
+        return true;
+    }
+
+    if (node != last)
+        memcpy(candidates + (size_t)node * count, candidates + (size_t)last * count, sizeof(int) * count);
+
+    for (size_t i = 0; i < stale.size(); i++)
+        buildNeighbors(stale[i], candidates + (size_t)stale[i] * count, true);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Move a node
+
+bool Instance::moveVertex(int node, const Vertex &vertex)
+{
+    const int count = getNeighbors();
+
+    if (node < 0 || node >= size || !editable())
+        return false;
+
+    vertices[node] = vertex;
+    hashed = false;
+    updateDistances(node);
+
+    if (candidates == NULL)
+        return true;
+
+    // Lists that hold the node may lose it; the others may take it
+
+    for (int i = 0; i < size; i++) {
+        int *row = candidates + (size_t)i * count;
+
+        if (i == node || std::find(row, row + count, node) != row + count)
+            buildNeighbors(i, row, true);
+        else
+            offerNeighbor(i, node);
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Map a raw distance matrix
+
+bool Instance::loadMatrix(const char *path, Weight weight)
+{
+    using namespace std;
+    struct stat status;
+    const size_t bytes = weightBytes(weight);
+    size_t side, length;
+    char *base;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &status) < 0) {
+        cerr << "Could not open file " << path << endl;
+
+        if (fd >= 0)
+            close(fd);
+
+        return false;
+    }
+
+    length = status.st_size;
+    side = (size_t)sqrt((double)(length / bytes));
+
+    while (side * side * bytes < length)
+        side++;
+
+    if (side == 0 || side > INT_MAX || side * side * bytes != length) {
+        cerr << "Read error: " << path << " does not hold a square matrix.\n";
+        close(fd);
+        return false;
+    }
+
+    base = (char *)mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        cerr << "Could not map file " << path << endl;
+        return false;
+    }
+
+    /*
+     * Rows are visited in no particular order, so the whole matrix is read
+     * ahead if it fits in memory. Otherwise, reading around each fault would
+     * only evict pages still in use.
+     */
+
+    const size_t memory = (size_t)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGE_SIZE);
+    madvise(base, length, length <= memory / 2 ? MADV_WILLNEED : MADV_RANDOM);
+
+    unmap();
+    Allocator::release(ids);
+    Allocator::release(distances);
+    Allocator::release(candidates);
+
+    mapping = base;
+    mappingSize = length;
+    size = side;
+    layout = Square;
+    metric = Explicit;
+    this->weight = weight;
+    vertices = Allocator::reallocate(vertices, size);
+    memset(vertices, 0, sizeof(Vertex) * size);
+    ids = NULL;
+    distances = (float *)base;
+    candidates = NULL;
+    hashed = false;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Load path from a TOUR file
+
+bool Instance::loadTour(const char *path, int *edges) const
+{
+    using namespace std;
+    Reader reader;
+    string key, value;
+    bool sized = false;
+
+    if (!reader.open(path)) {
+        cerr << "No se pudo abrir el archivo " << path << endl;
+        return false;
+    }
+
+    while (reader.keyword(key, value)) {
+        if (key == "EOF")
+            break;
+        else if (key == "TYPE") {
+            if (value != "TOUR") {
+                cerr << "Read error: Expected <TYPE==TOUR> and got <" << value << ">\n";
+                return false;
+            }
+        } else if (key == "DIMENSION") {
+            if (atoi(value.c_str()) != size) {
+                cerr << "Reading error: the path dimension is incorrect.\n";
+                return false;
+            }
+
+            sized = true;
+        } else if (key == "TOUR_SECTION") {
+            if (!sized) {
+                cerr << "Reading error: label <DIMENSION> not found.\n";
+                return false;
+            }
+
+            for (int i = 0; i < size; i++) {
+                double node;
+
+                if (!reader.number(node) || node < 1 || node > size) {
+                    cerr << "Error de lectura: faltan nodos.\n";
+                    return false;
+                }
+
+                edges[i] = (int)node - 1;
+            }
+
+            // A repeated node would leave another one out of the tour
+
+            std::vector<bool> seen(size, false);
+
+            for (int i = 0; i < size; i++) {
+                if (seen[edges[i]]) {
+                    cerr << "Read error: node " << edges[i] + 1 << " is repeated in TOUR_SECTION.\n";
+                    return false;
+                }
+
+                seen[edges[i]] = true;
+            }
+
+            // Translate original numbers into node indexes
+
+            if (ids != NULL) {
+                std::vector<int> indexes(size);
+
+                for (int i = 0; i < size; i++)
+                    indexes[ids[i]] = i;
+
+                for (int i = 0; i < size; i++)
+                    edges[i] = indexes[edges[i]];
+            }
+
+            return true;
+        }
+    }
+
+    cerr << "Error de lectura: texto <TOUR_SECTION> no encontrado.\n";
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Save route to a TOUR file
+
+bool Instance::saveTour(const char *path, const int *edges) const
+{
+    using namespace std;
+    ofstream file(path);
+
+    if (!file) {
+        cerr << "No se pudo abrir el archivo " << path << endl;
+        return false;
+    }
+
+    // Head
+
+    file << "NAME : " << path << endl;
+    file << "TYPE : TOUR\n";
+    file << "DIMENSION : " << size << endl;
+    file << "TOUR_SECTION\n";
+
+    // List of node indexes (edges)
+
+    for (int i = 0; i < size; i++)
+        file << idOf(edges[i]) + 1 << endl;
+
+    file << "EOF";
+
+    if (!file) {
+        cerr << "Error de escritura en archivo.\n";
+        file.close();
+        return false;
+    }
+
+    file.close();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Compile the instance to a binary file
+
+bool Instance::saveBinary(const char *path) const
+{
+    using namespace std;
+    const int *table = neighbors();
+    const int count = getNeighbors();
+    const size_t sections[4] = {
+        sizeof(Vertex) * size,
+        ids == NULL ? 0 : sizeof(int) * size,
+        weightBytes(weight) * matrixCells(size, layout),
+        sizeof(int) * size * count
+    };
+    const void *buffers[4] = { vertices, ids, distances, table };
+    uint64_t offsets[4];
+    uint64_t offset = sizeof(BinaryHeader);
+    BinaryHeader header;
+    ofstream file(path, ios_base::binary);
+
+    if (!file) {
+        cerr << "No se pudo abrir el archivo " << path << endl;
+        return false;
+    }
+
+    // Every section starts at a page boundary, so that it can be mapped apart
+
+    for (int i = 0; i < 4; i++) {
+        if (sections[i] == 0) {
+            offsets[i] = 0;
+            continue;
+        }
+
+        offset = (offset + BINARY_ALIGNMENT - 1) / BINARY_ALIGNMENT * BINARY_ALIGNMENT;
+        offsets[i] = offset;
+        offset += sections[i];
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+    header.version = BINARY_VERSION;
+    header.layout = layout;
+    header.metric = metric;
+    header.size = size;
+    header.neighbors = count;
+    header.weight = weight;
+    header.hash = getHash();
+    header.vertices = offsets[0];
+    header.ids = offsets[1];
+    header.distances = offsets[2];
+    header.candidates = offsets[3];
+    header.length = offset;
+
+    file.write((const char *)&header, sizeof(header));
+
+    for (int i = 0; i < 4; i++) {
+        if (sections[i] == 0)
+            continue;
+
+        while ((uint64_t)file.tellp() < offsets[i])
+            file.put('\0');
+
+        file.write((const char *)buffers[i], sections[i]);
+    }
+
+    if (!file) {
+        cerr << "Error de escritura en archivo.\n";
+        file.close();
+        return false;
+    }
+
+    file.close();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Check the node numbers of a compiled instance
+ * @param base Start of the mapped file.
+ * @param header Header of the file, already checked against its length.
+ *
+ * The original numbers must be a permutation of [0, size[, and every
+ * candidate must be a node. The distance matrix is not read, so its pages
+ * are still only loaded when they are used.
+ *
+ * @return Whether the numbers are valid.
+ */
+static bool validNodes(const char *base, const BinaryHeader &header)
+{
+    if (header.ids != 0) {
+        const int *ids = (const int *)(base + header.ids);
+        std::vector<bool> seen(header.size, false);
+
+        for (int i = 0; i < header.size; i++) {
+            if (ids[i] < 0 || ids[i] >= header.size || seen[ids[i]])
+                return false;
+
+            seen[ids[i]] = true;
+        }
+    }
+
+    if (header.candidates != 0) {
+        const int *candidates = (const int *)(base + header.candidates);
+        const size_t count = (size_t)header.size * header.neighbors;
+
+        for (size_t k = 0; k < count; k++) {
+            if (candidates[k] < 0 || candidates[k] >= header.size)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Map a compiled instance
+
+bool Instance::loadBinary(const char *path)
+{
+    using namespace std;
+    struct stat status;
+    const BinaryHeader *header;
+    char *base;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &status) < 0 || (size_t)status.st_size < sizeof(BinaryHeader)) {
+        cerr << "Could not open file " << path << endl;
+
+        if (fd >= 0)
+            close(fd);
+
+        return false;
+    }
+
+    // Pages are read on demand, so mapping costs the same for any size
+
+    base = (char *)mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        cerr << "Could not map file " << path << endl;
+        return false;
+    }
+
+    header = (const BinaryHeader *)base;
+
+    const size_t length = status.st_size;
+    const bool valid = header->version == BINARY_VERSION && header->length == length
+                       && header->size > 0 && header->neighbors >= 0 && header->layout <= Tiled && header->metric <= Explicit && header->weight <= UInt16
+                       && header->vertices + sizeof(Vertex) * header->size <= length
+                       && header->ids + sizeof(int) * header->size <= length
+                       && header->distances + weightBytes((Weight)header->weight) * matrixCells(header->size, (Layout)header->layout) <= length
+                       && header->candidates + sizeof(int) * header->size * header->neighbors <= length
+                       && header->vertices != 0 && header->distances != 0;
+
+    if (!valid) {
+        cerr << "Read error: unsupported or truncated compiled instance.\n";
+        munmap(base, length);
+        return false;
+    }
+
+    // Node numbers index arrays, so a corrupt file must not get past here
+
+    if (!validNodes(base, *header)) {
+        cerr << "Read error: compiled instance " << path << " is corrupt.\n";
+        munmap(base, length);
+        return false;
+    }
+
+    unmap();
+    Allocator::release(vertices);
+    Allocator::release(ids);
+    Allocator::release(distances);
+    Allocator::release(candidates);
+
+    mapping = base;
+    mappingSize = length;
+    size = header->size;
+    layout = (Layout)header->layout;
+    metric = (Metric)header->metric;
+    weight = (Weight)header->weight;
+    vertices = (Vertex *)(base + header->vertices);
+    ids = header->ids == 0 ? NULL : (int *)(base + header->ids);
+    distances = (float *)(base + header->distances);
+    candidates = NULL;
+    hash = header->hash;
+    hashed = true;
+
+    // Lists of another length are built again when needed
+
+    if (header->candidates != 0 && header->neighbors == getNeighbors())
+        candidates = (int *)(base + header->candidates);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Drop the mapping of a compiled instance
+
+void Instance::unmap()
+{
+    if (mapping == NULL)
+        return;
+
+    const char *begin = (const char *)mapping;
+    const char *end = begin + mappingSize;
+
+    if ((const char *)vertices >= begin && (const char *)vertices < end)
+        vertices = NULL;
+
+    if ((const char *)ids >= begin && (const char *)ids < end)
+        ids = NULL;
+
+    if ((const char *)distances >= begin && (const char *)distances < end)
+        distances = NULL;
+
+    if ((const char *)candidates >= begin && (const char *)candidates < end)
+        candidates = NULL;
+
+    munmap(mapping, mappingSize);
+    mapping = NULL;
+    mappingSize = 0;
+}
+
+//------------------------------------------------------------------------------
+// Get the content hash
+
+uint64_t Instance::getHash() const
+{
+    std::lock_guard<std::mutex> lock(hashLock);
+
+    if (!hashed) {
+        hash = computeHash();
+        hashed = true;
+    }
+
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+// Content hash of the current nodes
+
+uint64_t Instance::computeHash() const
+{
+    std::vector<int> positions(size);
+    uint64_t result = fnv(0xcbf29ce484222325ULL, &size, sizeof(size));
+
+    result = fnv(result, &metric, sizeof(metric));
+
+    for (int i = 0; i < size; i++)
+        positions[idOf(i)] = i;
+
+    for (int i = 0; i < size; i++) {
+        result = fnv(result, &vertices[positions[i]].x, sizeof(float));
+        result = fnv(result, &vertices[positions[i]].y, sizeof(float));
+    }
+
+    if (metric == Explicit) {
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < i; j++) {
+                const float d = distance(i, j);
+                result = fnv(result, &d, sizeof(float));
+            }
+        }
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Update distance matrix
+
+void Instance::updateDistances()
+{
+    float *cell = distances;
+
+    /*
+     * The lower triangle is computed row by row, which is exactly the order of
+     * the packed layout. Full layouts mirror each cell to the upper half.
+     */
+
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < i; j++) {
+            register float d = measure(metric, vertices[i], vertices[j]);
+
+            if (layout == Packed)
+                *cell++ = d;
+            else
+                distances[cellIndex(i, j)] = distances[cellIndex(j, i)] = d;
+        }
+
+        if (layout == Packed)
+            *cell++ = 0.0;
+        else
+            distances[cellIndex(i, i)] = 0.0;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Compute the distances of a node
+
+void Instance::updateDistances(int node)
+{
+    for (int j = 0; j < size; j++) {
+        const float d = j == node ? 0.0 : measure(metric, vertices, node, j);
+
+        distances[cellIndex(node, j)] = d;
+
+        if (layout != Packed)
+            distances[cellIndex(j, node)] = d;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Make the instance editable
+
+bool Instance::editable()
+{
+    if (metric == Explicit || weight != Float32) {
+        std::cerr << "Nodes given by explicit weights cannot be edited.\n";
+        return false;
+    }
+
+    if (mapping == NULL)
+        return true;
+
+    // A compiled instance is copied out of its read-only mapping, once
+
+    const char *begin = (const char *)mapping;
+    const bool mappedCandidates = (const char *)candidates >= begin && (const char *)candidates < begin + mappingSize;
+    const size_t cells = matrixCells(size, layout);
+    Vertex *newVertices = Allocator::allocate<Vertex>(size);
+    int *newIds = ids == NULL ? NULL : Allocator::allocate<int>(size);
+    float *newDistances = Allocator::allocate<float>(cells);
+    int *newCandidates = candidates;
+
+    memcpy(newVertices, vertices, sizeof(Vertex) * size);
+    memcpy(newDistances, distances, sizeof(float) * cells);
+
+    if (newIds != NULL)
+        memcpy(newIds, ids, sizeof(int) * size);
+
+    if (mappedCandidates) {
+        newCandidates = Allocator::allocate<int>((size_t)size * getNeighbors() + 1);
+        memcpy(newCandidates, candidates, sizeof(int) * size * getNeighbors());
+    }
+
+    unmap();
+    vertices = newVertices;
+    ids = newIds;
+    distances = newDistances;
+    candidates = newCandidates;
+    capacity = size;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Prepare the derived data of new nodes
+
+void Instance::prepare(Order order)
+{
+    Allocator::release(ids);
+    Allocator::release(candidates);
+    ids = NULL;
+    candidates = NULL;
+
+    // Weights given explicitly are already in place, in the original order
+
+    hashed = false;
+
+    if (metric == Explicit)
+        return;
+
+    if (order == Hilbert)
+        sortHilbert();
+
+    updateDistances();
+}
+
+//------------------------------------------------------------------------------
+// Renumber nodes along a Hilbert curve
+
+void Instance::sortHilbert()
+{
+    const unsigned int side = 1 << 16;
+    float minX = FLT_MAX, minY = FLT_MAX;
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+    std::vector<std::pair<unsigned long long, int> > keys(size);
+    std::vector<Vertex> sorted(size);
+
+    for (int i = 0; i < size; i++) {
+        minX = std::min(minX, vertices[i].x);
+        minY = std::min(minY, vertices[i].y);
+        maxX = std::max(maxX, vertices[i].x);
+        maxY = std::max(maxY, vertices[i].y);
+    }
+
+    const double scale = (side - 1) / std::max(std::max(maxX - minX, maxY - minY), FLT_MIN);
+
+    /*
+     * Each node is snapped to a grid of side x side cells, and its position
+     * along the curve is computed quadrant by quadrant (from the largest one),
+     * rotating the coordinates so that every quadrant is a copy of the curve.
+     */
+
+    for (int i = 0; i < size; i++) {
+        unsigned int x = (unsigned int)((vertices[i].x - minX) * scale);
+        unsigned int y = (unsigned int)((vertices[i].y - minY) * scale);
+        unsigned long long d = 0;
+
+        for (unsigned int s = side / 2; s > 0; s /= 2) {
+            unsigned int rx = (x & s) > 0;
+            unsigned int ry = (y & s) > 0;
+            d += (unsigned long long)s * s * ((3 * rx) ^ ry);
+
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = side - 1 - x;
+                    y = side - 1 - y;
+                }
+
+                std::swap(x, y);
+            }
+        }
+
+        keys[i] = std::make_pair(d, i);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    ids = Allocator::reallocate(ids, size);
+
+    for (int i = 0; i < size; i++) {
+        ids[i] = keys[i].second;
+        sorted[i] = vertices[ids[i]];
+    }
+
+    memcpy(vertices, sorted.data(), sizeof(Vertex) * size);
+}
+
+//------------------------------------------------------------------------------
+// Candidate lists of the nodes
+
+const int * Instance::neighbors() const
+{
+    std::lock_guard<std::mutex> lock(candidatesLock);
+
+    if (candidates == NULL)
+        updateNeighbors();
+
+    return candidates;
+}
+
+//------------------------------------------------------------------------------
+// Build the candidate lists
+
+void Instance::updateNeighbors() const
+{
+    const int count = getNeighbors();
+    int *table = Allocator::allocate<int>((size_t)size * count + 1);
+
+    for (int i = 0; i < size; i++)
+        buildNeighbors(i, table + (size_t)i * count, false);
+
+    candidates = table;
+}
+
+//------------------------------------------------------------------------------
+// Build the candidate list of a node
+
+void Instance::buildNeighbors(int node, int *row, bool measured) const
+{
+    const int count = getNeighbors();
+    float lengths[NEIGHBORS];
+    int length = 0;
+
+    /*
+     * The row is kept sorted by insertion, so that a node only costs a
+     * comparison against the farthest candidate unless it gets in the list.
+     * Nodes come by index, so ties keep the lower index first.
+     */
+
+    for (int j = 0; j < size; j++) {
+        if (j == node)
+            continue;
+
+        const float d = measured ? measure(metric, vertices, node, j) : distance(node, j);
+        int k = length;
+
+        if (length == count) {
+            if (d >= lengths[count - 1])
+                continue;
+
+            k--;
+        } else
+            length++;
+
+        for (; k > 0 && lengths[k - 1] > d; k--) {
+            row[k] = row[k - 1];
+            lengths[k] = lengths[k - 1];
+        }
+
+        row[k] = j;
+        lengths[k] = d;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Offer a node to the candidate list of another
+
+void Instance::offerNeighbor(int node, int other) const
+{
+    const int count = getNeighbors();
+    int *row = candidates + (size_t)node * count;
+    const float d = measure(metric, vertices, node, other);
+    int k = count;
+
+    // Same order as buildNeighbors(): by distance, then by index
+
+    for (; k > 0; k--) {
+        const float e = measure(metric, vertices, node, row[k - 1]);
+
+        if (e < d || (e == d && row[k - 1] < other))
+            break;
+
+        if (k < count)
+            row[k] = row[k - 1];
+    }
+
+    if (k < count)
+        row[k] = other;
+}
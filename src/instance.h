@@ -0,0 +1,525 @@
+/**
+ * @file instance.h
+ * @brief Declaration of the Instance class
+ * @date October 18, 2026
+ */
+
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <mutex>
+
+#define TILE_SHIFT 4                ///< Log2 of the side of a matrix tile
+#define TILE_SIDE (1 << TILE_SHIFT) ///< Side of a matrix tile (in cells)
+#define NEIGHBORS 10                ///< Length of the candidate lists
+#define BINARY_MAGIC "TSPBIN\r\n"    ///< First bytes of a compiled instance
+#define BINARY_VERSION 2            ///< Version of the compiled format
+#define BINARY_ALIGNMENT 4096       ///< Alignment of each section (a page)
+
+/**
+ * @brief Instance Class
+ *
+ * Holds the nodes of a problem and their distance matrix. An instance is
+ * shared by every Cycle built from it, so it must not change while a search
+ * is using it. Between searches, its owner may add, remove or move nodes
+ * with addVertex(), removeVertex() and moveVertex(), which update the matrix
+ * and the candidate lists in place instead of computing them again.
+ *
+ * An instance can be compiled to a binary file with saveBinary(): a header
+ * followed by page-aligned sections with the coordinates, the original
+ * numbers, the distance matrix and the candidate lists. Loading that file maps
+ * it into memory and points straight at the sections, so nothing is parsed or
+ * computed, and pages are only read from disk when they are first used.
+ */
+class Instance
+{
+public:
+
+    /// Structure of each node of the graph
+    struct Vertex {
+        float x;
+        float y;
+    };
+
+    /// Storage layout of the distance matrix
+    enum Layout {
+        Packed, ///< Lower triangle (with diagonal), row by row
+        Square, ///< Full row-major matrix
+        Tiled   ///< Full matrix split in row-major square tiles
+    };
+
+    /// Edge weight type (TSPLIB)
+    enum Metric {
+        Euc2D,      ///< Euclidean distance, truncated
+        Ceil2D,     ///< Euclidean distance, rounded up
+        Att,        ///< Pseudo-Euclidean distance
+        Geo,        ///< Geographical distance
+        Explicit    ///< Weights given in the file
+    };
+
+    /// Type of the cells of the distance matrix
+    enum Weight {
+        Float32,    ///< 32-bit floating point
+        Int32,      ///< 32-bit signed integer
+        UInt16      ///< 16-bit unsigned integer
+    };
+
+    /// Numbering of the nodes after loading them
+    enum Order {
+        Original,   ///< Order of the TSP file
+        Hilbert     ///< Position along a Hilbert curve over the nodes
+    };
+
+    /**
+     * @brief Default constructor
+     *
+     * Creates an empty graph.
+     */
+    Instance();
+
+    /**
+     * @brief Constructor with assigned size
+     * @param size Size of the graph.
+     *
+     * Every node is placed at the origin.
+     */
+    explicit Instance(int size);
+
+    /// Destructor
+    ~Instance();
+
+    /**
+     * @brief Load nodes from a TSP file
+     * @param path File path.
+     * @param layout Storage layout of the distance matrix.
+     * @param order Numbering of the nodes.
+     * @post The distance matrix is updated implicitly.
+     *
+     * With the Hilbert order, nodes that are close in the plane get close
+     * indices, so do their rows in the distance matrix. The original numbers
+     * are kept for loadTour(), saveTour() and idOf().
+     *
+     * The edge weight types EUC_2D, CEIL_2D, ATT, GEO and EXPLICIT are
+     * supported, the latter in the FULL_MATRIX, UPPER_ROW, LOWER_ROW,
+     * UPPER_DIAG_ROW and LOWER_DIAG_ROW formats. Explicit weights keep the
+     * original order, whatever @p order is.
+     *
+     * A compiled instance (see saveBinary()) is recognized by its first bytes
+     * and mapped instead, with the layout and order it was compiled with.
+     *
+     * @return Whether it was read correctly.
+     */
+    bool loadTsp(const char *path, Layout layout = Packed, Order order = Original);
+
+    /**
+     * @brief Load nodes from memory
+     * @param vertices Coordinates of the nodes.
+     * @param size Number of nodes.
+     * @param layout Storage layout of the distance matrix.
+     * @param order Numbering of the nodes.
+     * @post The distance matrix is updated implicitly.
+     * @return Whether the nodes were accepted (at least one).
+     */
+    bool loadVertices(const Vertex *vertices, int size, Layout layout = Packed, Order order = Original);
+
+    /**
+     * @brief Map a raw distance matrix
+     * @param path Path of a file with the full matrix, row by row.
+     * @param weight Type of the cells (in the byte order of the machine).
+     *
+     * The number of nodes is taken from the length of the file, which must
+     * hold a square matrix. Distances are read straight from the mapping: the
+     * matrix is neither copied nor converted, and its pages are read ahead if
+     * it fits in half the physical memory. The nodes have no coordinates,
+     * the layout is Square and the metric is Explicit.
+     *
+     * @return Whether the file was mapped.
+     */
+    bool loadMatrix(const char *path, Weight weight);
+
+    /**
+     * @brief Load path from a TOUR file
+     * @param path File path.
+     * @param edges Destination of the path (getSize() nodes).
+     * @return Whether it was read correctly.
+     */
+    bool loadTour(const char *path, int *edges) const;
+
+    /**
+     * @brief Save route to a TOUR file
+     * @param path Path of the destination file.
+     * @param edges Path to save (getSize() nodes).
+     * @return Whether it was written correctly.
+     */
+    bool saveTour(const char *path, const int *edges) const;
+
+    /**
+     * @brief Compile the instance to a binary file
+     * @param path Path of the destination file.
+     *
+     * The candidate lists are built if they were not, so that they are stored
+     * too. The file can only be read on machines with the same byte order.
+     *
+     * @return Whether it was written correctly.
+     */
+    bool saveBinary(const char *path) const;
+
+    /**
+     * @brief Add a node
+     * @param vertex Coordinates of the node.
+     *
+     * The node gets the last index and the next original number. Its row of
+     * the distance matrix is computed, the candidate lists (if they were
+     * built) take it where it is closer than their farthest entry, and its own
+     * list is built with a scan. That is O(n) with the packed layout; the full
+     * layouts compute the whole matrix again. Buffers grow ahead of the size,
+     * so most additions do not move them.
+     *
+     * @pre No search must be using the instance.
+     * @return Index of the new node, or -1 if the instance has no coordinates
+     *         (explicit weights).
+     */
+    int addVertex(const Vertex &vertex);
+
+    /**
+     * @brief Remove a node
+     * @param node Index of the node.
+     *
+     * The last node takes the index of the removed one, and original numbers
+     * above that of the removed node go down by one, as if it was erased from
+     * the TSP file. Only the lists that held either node are built again.
+     *
+     * @pre No search must be using the instance.
+     * @return Whether the node was removed (the instance keeps a node at least).
+     */
+    bool removeVertex(int node);
+
+    /**
+     * @brief Move a node
+     * @param node Index of the node.
+     * @param vertex New coordinates.
+     *
+     * The row and column of the node are computed again, so are its list and
+     * the lists that held it; the others take it if it came closer.
+     *
+     * @pre No search must be using the instance.
+     * @return Whether the node was moved.
+     */
+    bool moveVertex(int node, const Vertex &vertex);
+
+    /**
+     * @brief Get size
+     * @return Number of nodes.
+     */
+    inline int getSize() const
+    {
+        return size;
+    }
+
+    /**
+     * @brief Get the layout of the distance matrix
+     * @return Layout chosen when the nodes were loaded.
+     */
+    inline Layout getLayout() const
+    {
+        return layout;
+    }
+
+    /**
+     * @brief Get the type of the matrix cells
+     * @return Float32 unless a raw matrix was mapped.
+     */
+    inline Weight getWeight() const
+    {
+        return weight;
+    }
+
+    /**
+     * @brief Get the edge weight type
+     * @return Metric of the distance matrix.
+     */
+    inline Metric getMetric() const
+    {
+        return metric;
+    }
+
+    /**
+     * @brief Get the content hash
+     *
+     * The hash covers the size, the metric, the coordinates in their original
+     * order and explicit weights, so it does not depend on the layout or the
+     * numbering. It is computed on the first call, which is safe from several
+     * threads at once, since it reads every weight of an explicit matrix.
+     *
+     * @return 64-bit FNV-1a hash of the nodes.
+     */
+    uint64_t getHash() const;
+
+    /**
+     * @brief Constant reference to vertex
+     * @param index Index of the vertex within the vector.
+     * @pre @index must be in the range [0, size[.
+     * @return Constant reference to the indicated vertex.
+     */
+    inline const Vertex & vertexAt(int index) const
+    {
+        return vertices[index];
+    }
+
+    /**
+     * @brief Original number of a node
+     * @param node Index of the node.
+     * @pre @node must be in the range [0, size[.
+     * @return Zero-based number that the node has in the TSP file.
+     */
+    inline int idOf(int node) const
+    {
+        return ids == NULL ? node : ids[node];
+    }
+
+    /**
+     * @brief Distance between two nodes
+     * @param i Index of one of the vertices.
+     * @param j Index of the other vertex.
+     * @pre @p i and @p j must be in the range [0, size[.
+     * @return Distance between the indicated vertices, by the metric.
+     */
+    inline float distance(int i, int j) const
+    {
+        const size_t cell = cellIndex(i, j);
+
+        switch (weight) {
+        case Int32:
+            return ((const int32_t *)distances)[cell];
+        case UInt16:
+            return ((const uint16_t *)distances)[cell];
+        default:
+            return distances[cell];
+        }
+    }
+
+    /**
+     * @brief Length of the candidate lists
+     * @return Number of neighbors listed for each node.
+     */
+    inline int getNeighbors() const
+    {
+        return size - 1 < NEIGHBORS ? size - 1 : NEIGHBORS;
+    }
+
+    /**
+     * @brief Candidate lists of the nodes
+     *
+     * Row @c i (of getNeighbors() entries) holds the nearest nodes to @c i,
+     * closest first. The table is built on the first call, which is safe from
+     * several threads at once, and shared afterwards.
+     *
+     * @return Table of neighbors.
+     */
+    const int * neighbors() const;
+
+    /**
+     * @brief Number of cells stored by a distance matrix
+     * @param size Size of the graph.
+     * @param layout Storage layout.
+     * @return Number of floats needed to hold the matrix.
+     */
+    static inline size_t matrixCells(int size, Layout layout)
+    {
+        const size_t tiles = ((size_t)size + TILE_SIDE - 1) >> TILE_SHIFT;
+
+        switch (layout) {
+        case Packed:
+            return (size_t)size * (size + 1) / 2;
+        case Tiled:
+            return tiles * tiles * TILE_SIDE * TILE_SIDE;
+        default:
+            return (size_t)size * size;
+        }
+    }
+
+    /**
+     * @brief Size of a matrix cell
+     * @param weight Type of the cell.
+     * @return Number of bytes.
+     */
+    static inline size_t weightBytes(Weight weight)
+    {
+        return weight == UInt16 ? sizeof(uint16_t) : sizeof(float);
+    }
+
+    /**
+     * @brief Index of a cell in a distance matrix
+     * @param i Index of one of the vertices.
+     * @param j Index of the other vertex.
+     * @param size Size of the graph.
+     * @param layout Storage layout.
+     * @return Offset of the cell within the distance vector.
+     */
+    static inline size_t cellIndex(int i, int j, int size, Layout layout)
+    {
+        switch (layout) {
+        case Packed:
+            return packedIndex(i, j);
+        case Tiled:
+            return tiledIndex(i, j, size);
+        default:
+            return (size_t)i * size + j;
+        }
+    }
+
+private:
+
+    int size;           ///< Graph size
+    int capacity;       ///< Nodes the buffers were grown for by addVertex()
+    Layout layout;      ///< Layout of the distance matrix
+    Metric metric;      ///< Edge weight type
+    Weight weight;      ///< Type of the matrix cells
+    Vertex *vertices;   ///< Vector of nodes
+    int *ids;           ///< Original number of each node (NULL if unchanged)
+    float *distances;   ///< Symmetric distance matrix (cells of type weight)
+    mutable int *candidates;        ///< Candidate lists (NULL until needed)
+    mutable std::mutex candidatesLock;
+    mutable uint64_t hash;          ///< Content hash
+    mutable bool hashed;            ///< Whether hash is up to date
+    mutable std::mutex hashLock;
+    void *mapping;      ///< Compiled file in memory (NULL if not mapped)
+    size_t mappingSize; ///< Length of the mapping
+
+    Instance(const Instance &);
+    Instance & operator=(const Instance &);
+
+    /**
+     * @brief Index of a cell in the distance matrix
+     * @param i Index of one of the vertices.
+     * @param j Index of the other vertex.
+     * @return Offset of the cell within the distance vector.
+     */
+    inline size_t cellIndex(int i, int j) const
+    {
+        return cellIndex(i, j, size, layout);
+    }
+
+    /**
+     * @brief Index of a cell in the packed matrix
+     * @param i Index of one of the vertices.
+     * @param j Index of the other vertex.
+     *
+     * Only the lower triangle is stored, so the pair is ordered as (max, min)
+     * with a sign mask instead of a comparison. Row @c r starts at r(r+1)/2.
+     *
+     * @return Offset of the cell within the distance vector.
+     */
+    static inline size_t packedIndex(int i, int j)
+    {
+        const int delta = i - j;
+        const int mask = delta >> (sizeof(int) * CHAR_BIT - 1);
+        const size_t row = i - (delta & mask);
+        const size_t column = j + (delta & mask);
+
+        return row * (row + 1) / 2 + column;
+    }
+
+    /**
+     * @brief Index of a cell in the tiled matrix
+     * @param i Index of one of the vertices.
+     * @param j Index of the other vertex.
+     * @param size Size of the graph.
+     *
+     * Tiles of TILE_SIDE x TILE_SIDE cells are stored contiguously, so every
+     * lookup between two nearby nodes falls in the same few cache lines.
+     *
+     * @return Offset of the cell within the distance vector.
+     */
+    static inline size_t tiledIndex(int i, int j, int size)
+    {
+        const size_t tiles = ((size_t)size + TILE_SIDE - 1) >> TILE_SHIFT;
+        const size_t tile = (i >> TILE_SHIFT) * tiles + (j >> TILE_SHIFT);
+
+        return (((tile << TILE_SHIFT) + (i & (TILE_SIDE - 1))) << TILE_SHIFT) + (j & (TILE_SIDE - 1));
+    }
+
+    /**
+     * @brief Map a compiled instance
+     * @param path File path.
+     * @return Whether the file was valid.
+     */
+    bool loadBinary(const char *path);
+
+    /**
+     * @brief Drop the mapping of a compiled instance
+     * @post Every buffer that pointed into the mapping is NULL.
+     */
+    void unmap();
+
+    /**
+     * @brief Content hash of the current nodes
+     * @return Hash of the size and the coordinates in original order.
+     */
+    uint64_t computeHash() const;
+
+    /**
+     * @brief Update distance matrix
+     *
+     * It must be called if any of the nodes are modified, and is necessary so
+     * that distance() returns correct results.
+     */
+    void updateDistances();
+
+    /**
+     * @brief Renumber nodes along a Hilbert curve
+     * @post ids holds the original number of each node.
+     */
+    void sortHilbert();
+
+    /**
+     * @brief Build the candidate lists
+     * @post candidates holds getNeighbors() nodes per row.
+     */
+    void updateNeighbors() const;
+
+    /**
+     * @brief Build the candidate list of a node
+     * @param node Index of the node.
+     * @param row Destination of getNeighbors() nodes.
+     * @param measured Whether to compute distances from the coordinates, which
+     *        avoids scattered reads of the matrix columns.
+     *
+     * Nodes are sorted by distance, then by index, so the list is the same
+     * whoever builds it.
+     */
+    void buildNeighbors(int node, int *row, bool measured) const;
+
+    /**
+     * @brief Offer a node to the candidate list of another
+     * @param node Index of the node that owns the list.
+     * @param other Index of the offered node, not in the list.
+     */
+    void offerNeighbor(int node, int other) const;
+
+    /**
+     * @brief Make the instance editable
+     * @post The sections of a compiled instance are copied out of the mapping.
+     * @return Whether the nodes have coordinates that define the distances.
+     */
+    bool editable();
+
+    /**
+     * @brief Compute the distances of a node
+     * @param node Index of the node.
+     * @post Its row and column of the matrix are up to date.
+     */
+    void updateDistances(int node);
+
+    /**
+     * @brief Prepare the derived data of new nodes
+     * @param order Numbering of the nodes.
+     * @post Numbering, candidate lists and distance matrix are up to date.
+     */
+    void prepare(Order order);
+};
+
+#endif /* INSTANCE_H */
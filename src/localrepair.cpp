@@ -0,0 +1,172 @@
+/**
+ * @file localrepair.cpp
+ * @brief 2-opt search around a few nodes of a tour
+ * @date October 19, 2026
+ */
+
+#include <deque>
+#include <vector>
+#include "cycle.h"
+#include "algorithms.h"
+
+#define REPAIR_EPSILON 1e-3f    ///< Smallest gain taken as an improvement
+
+namespace Algorithms
+{
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Reverse a subpath that may wrap around the end of the path
+ * @param data Tour.
+ * @param positions Position of each node in the path, kept up to date.
+ * @param first Position of the first node of the subpath.
+ * @param last Position of the last node of the subpath.
+ *
+ * Reversing the rest of the path gives the same cycle, so the shorter of the
+ * two is reversed (which may leave the whole cycle in the other direction).
+ */
+static void reverse(Cycle &data, std::vector<int> &positions, int first, int last)
+{
+    const int size = data.getSize();
+    int length = (last - first + size) % size + 1;
+
+    if (2 * length > size) {
+        const int next = (last + 1) % size;
+        last = (first + size - 1) % size;
+        first = next;
+        length = size - length;
+    }
+
+    for (int k = 0; k < length / 2; k++) {
+        const int node = data.edgeAt(first);
+
+        data.edgeAt(first) = data.edgeAt(last);
+        data.edgeAt(last) = node;
+        positions[data.edgeAt(first)] = first;
+        positions[node] = last;
+        first = (first + 1) % size;
+        last = (last + size - 1) % size;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Apply the first improving 2-opt move at a node
+ * @param data Tour.
+ * @param positions Position of each node in the path.
+ * @param node Node whose edges are tried.
+ * @param ends Destination of the four nodes of the move.
+ *
+ * Each edge of the node is replaced by an edge to one of its candidates,
+ * which only pays while the candidate is closer than the removed neighbor.
+ *
+ * @return Whether a move was applied.
+ */
+static bool improve(Cycle &data, std::vector<int> &positions, int node, int ends[4])
+{
+    const int size = data.getSize();
+    const int count = data.getInstance()->getNeighbors();
+    const int *row = data.getInstance()->neighbors() + (size_t)node * count;
+
+    for (int side = 0; side < 2; side++) {
+        const int step = side == 0 ? 1 : size - 1;
+        const int mate = data.edgeAt((positions[node] + step) % size);
+        const float removed = data.distance(node, mate);
+
+        for (int k = 0; k < count; k++) {
+            const int other = row[k];
+            const float gain = removed - data.distance(node, other);
+
+            if (gain <= REPAIR_EPSILON)
+                break;
+
+            const int otherMate = data.edgeAt((positions[other] + step) % size);
+
+            if (other == mate || otherMate == node)
+                continue;
+
+            if (gain + data.distance(other, otherMate) - data.distance(mate, otherMate) <= REPAIR_EPSILON)
+                continue;
+
+            // Forward: node mate ... other otherMate; backward: mate node ... otherMate other
+
+            if (side == 0)
+                reverse(data, positions, positions[mate], positions[other]);
+            else
+                reverse(data, positions, positions[node], positions[otherMate]);
+
+            ends[0] = node;
+            ends[1] = mate;
+            ends[2] = other;
+            ends[3] = otherMate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
+int localRepair(Cycle &data, const int *nodes, int count, Deadline &deadline)
+{
+    const int size = data.getSize();
+    std::vector<int> positions(size);
+    std::vector<bool> queued(size, false);
+    std::deque<int> queue;
+    int ends[4];
+    int moves = 0;
+
+    if (size < 5)
+        return 0;
+
+    for (int i = 0; i < size; i++)
+        positions[data.edgeAt(i)] = i;
+
+    /*
+     * Only the given nodes and their neighbors in the path are queued. A node
+     * whose edges change is queued again, so the search spreads from there
+     * while it keeps finding improvements, and stops where the tour is
+     * already 2-optimal.
+     */
+
+    for (int i = 0; i < count; i++) {
+        if (nodes[i] < 0 || nodes[i] >= size)
+            continue;
+
+        for (int offset = size - 1; offset <= size + 1; offset++) {
+            const int node = data.edgeAt((positions[nodes[i]] + offset) % size);
+
+            if (!queued[node]) {
+                queued[node] = true;
+                queue.push_back(node);
+            }
+        }
+    }
+
+    while (!queue.empty() && !deadline.expired()) {
+        const int node = queue.front();
+
+        if (!improve(data, positions, node, ends)) {
+            queue.pop_front();
+            queued[node] = false;
+            continue;
+        }
+
+        moves++;
+
+        for (int k = 1; k < 4; k++) {
+            if (!queued[ends[k]]) {
+                queued[ends[k]] = true;
+                queue.push_back(ends[k]);
+            }
+        }
+    }
+
+    data.updateCost();
+    return moves;
+}
+
+}
@@ -8,7 +8,7 @@
 namespace Algorithms
 {
 
-int localSearch(Cycle &data)
+int localSearch(Cycle &data, Deadline &deadline)
 {
     const int evalsPerLoop = (int)(data.getCost() * data.getCost()) / 2;
     int evals = 0;
@@ -27,6 +27,11 @@ int localSearch(Cycle &data)
         updated = false;
 
         for (int i = 1; i < data.getSize(); i++) {
+            // Stop with the best neighbor found so far
+
+            if (deadline.expired())
+                return evals;
+
             for (int j = 0; j < i; j++) {
                 curCycle.swap(i, j);
 
@@ -45,16 +50,16 @@ int localSearch(Cycle &data)
     return evals;
 }
 
-void localSearch(Cycle &data, unsigned int seed)
+void localSearch(Cycle &data, unsigned int seed, Deadline &deadline)
 {
-    std::mt19937 generator(seed);
-    localSearch(data, generator);
+    Generator generator(seed);
+    localSearch(data, generator, deadline);
 }
 
-void localSearch(Cycle &data, std::mt19937 &generator)
+void localSearch(Cycle &data, Generator &generator, Deadline &deadline)
 {
     data.shufflePath(generator);
-    localSearch(data);
+    localSearch(data, deadline);
 }
 
 }
@@ -5,335 +5,499 @@
 #include <cstring>
 #include <cmath>
 #include <ctime>
-#include "cycle.h"
-#include "algorithms.h"
+#include <chrono>
+#include <thread>
+#include <csignal>
+#include <memory>
+#include <unistd.h>
+#include "tsp.h"
+#include "daemon.h"
+#include "batch.h"
+#include "checkpoint.h"
 
 using std::cout;
 using std::cin;
 using std::cerr;
 using std::endl;
 
-static enum Algorithm { None, Greedy, RS, LS, VND, SA,
-                        GreedyLS, GreedyLSExt, BMB, Grasp, GraspExt, ILS, VNS,
-                        Genetic, Memetic, ParallelSA, ParallelGenetic
-                      } algorithm = None;
-
-static char *pathTSP = NULL;
-static char *pathTOUR_in = NULL;
-static char *pathTOUR_out = NULL;
-static int count = 2000;
-static int size = 30;
-static int processes = 5;
-static int migrLatency = 1;
-static unsigned int seed = 0;
-static Algorithms::NeighborGenerator generator = Algorithms::Swap;
-static Algorithms::Scheme scheme = Algorithms::Generational;
-static Algorithms::Hybridization hybridization = Algorithms::Everygen_Everychrom;
-static Algorithms::Topology topology = Algorithms::Ring;
-
-static bool config(int argc, char **argv);
+/// Options of the command line
+struct Options {
+    Algorithms::Settings settings;  ///< Configuration of the solve
+    char *pathTSP;
+    char *pathTOUR_in;
+    char *pathTOUR_out;
+    char *pathCompiled;     ///< Destination of the compiled instance
+    bool matrix;            ///< Whether the TSP file is a raw matrix
+    Instance::Weight weight;    ///< Type of the cells of the raw matrix
+    Instance::Layout layout;
+    Instance::Order order;
+    Allocator::Pages pages;
+    bool firstTouch;
+    bool memStats;
+    bool daemon;            ///< Serve requests instead of solving once
+    char *pathSocket;       ///< Socket of the daemon (NULL for stdin)
+    char *pathBatch;        ///< Manifest of a batch (NULL for none)
+    int workers;            ///< Worker threads of the daemon or the batch
+    int cache;              ///< Problems kept by the daemon
+    long timeLimit;         ///< Wall time budget in milliseconds (0: none)
+    char *pathCheckpoint;   ///< Destination of the checkpoints (NULL for none)
+    char *pathResume;       ///< Checkpoint to resume (NULL for none)
+    long checkpointInterval;    ///< Milliseconds between checkpoints
+    char *pathResults;      ///< Directory of the result cache (NULL for none)
+    long resultsCapacity;   ///< Maximum bytes of the result cache
+    bool startBest;         ///< Start from the best known tour of the cache
+
+    Options()
+    {
+        pathTSP = NULL;
+        pathTOUR_in = NULL;
+        pathTOUR_out = NULL;
+        pathCompiled = NULL;
+        matrix = false;
+        weight = Instance::Float32;
+        layout = Instance::Packed;
+        order = Instance::Original;
+        pages = Allocator::Normal;
+        firstTouch = false;
+        memStats = false;
+        daemon = false;
+        pathSocket = NULL;
+        pathBatch = NULL;
+        workers = std::thread::hardware_concurrency();
+        cache = 64;
+        timeLimit = 0;
+        pathCheckpoint = NULL;
+        pathResume = NULL;
+        checkpointInterval = 60000;
+        pathResults = NULL;
+        resultsCapacity = 256L << 20;
+        startBest = false;
+    }
+};
+
+static bool config(int argc, char **argv, Options &options);
 static void printHelp();
 
+/// Stop the search and keep the best tour (a second signal kills the process)
+static void stopSearch(int)
+{
+    Algorithms::Deadline::interrupt();
+}
+
 int main(int argc, char **argv)
 {
     clock_t t0, t1;
+    std::chrono::steady_clock::time_point w0, w1;
+    struct sigaction action;
     Cycle data;
-    seed = (unsigned int)time(NULL);
+    Options options;
+    std::unique_ptr<Algorithms::Checkpoint> checkpoint;
+    std::unique_ptr<Tsp::ResultCache> results;
+    uint64_t key = 0;
+    bool cached = false;
 
-    if (!config(argc, argv)) {
+    options.settings.seed = (unsigned int)time(NULL);
+
+    if (!config(argc, argv, options)) {
         printHelp();
         return EXIT_FAILURE;
     }
 
-    if (!data.loadTsp(pathTSP))
-        return EXIT_FAILURE;
+    Allocator::configure(options.pages, options.firstTouch);
 
-    t0 = clock();
+    if (options.pathResults != NULL) {
+        results.reset(new Tsp::ResultCache(options.pathResults, options.resultsCapacity));
 
-    switch (algorithm) {
-    case None:
-        if (pathTOUR_in != NULL)
-            data.loadTour(pathTOUR_in);
-        else {
-            cerr << "Nothing to do...\n";
+        if (!results->open())
             return EXIT_FAILURE;
-        }
-        break;
+    }
 
-    case Greedy:
-        Algorithms::greedy(data);
-        break;
+    if (options.daemon) {
+        Tsp::Daemon daemon(options.workers, options.cache, options.layout, options.order, results.get());
 
-    case RS:
-        Algorithms::randomSearch(data, count, seed);
-        break;
+        if (options.pathSocket != NULL)
+            return daemon.listen(options.pathSocket) ? EXIT_SUCCESS : EXIT_FAILURE;
 
-    case LS:
-        Algorithms::localSearch(data, seed);
-        break;
+        daemon.serve(STDIN_FILENO, STDOUT_FILENO);
+        return EXIT_SUCCESS;
+    }
 
-    case VND:
-        Algorithms::descendantSearch(data, count, seed);
-        break;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stopSearch;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
 
-    case SA:
-        Algorithms::simulatedAnnealing(data, count, seed, generator);
-        break;
+    if (options.pathBatch != NULL) {
+        Tsp::Batch batch(options.workers, options.layout, options.order, results.get());
 
-    case GreedyLS:
-        Algorithms::greedy_bl(data);
-        break;
+        if (!batch.load(options.pathBatch))
+            return EXIT_FAILURE;
 
-    case GreedyLSExt:
-        Algorithms::greedy_blext(data, count, seed);
-        break;
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
 
-    case BMB:
-        Algorithms::basicMultibootSearch(data, count, seed);
-        break;
+        if (!batch.run(cout)) {
+            cerr << "Interrupted: the remaining jobs were skipped.\n";
+            return EXIT_FAILURE;
+        }
 
-    case Grasp:
-        Algorithms::grasp(data, count, seed);
-        break;
+        return EXIT_SUCCESS;
+    }
 
-    case GraspExt:
-        Algorithms::graspExt(data, count, seed);
-        break;
+    if (options.matrix) {
+        if (!data.loadMatrix(options.pathTSP, options.weight))
+            return EXIT_FAILURE;
+    } else if (!data.loadTsp(options.pathTSP, options.layout, options.order))
+        return EXIT_FAILURE;
 
-    case ILS:
-        Algorithms::iteratedLocalSearch(data, count, seed);
-        break;
+    if (options.pathCompiled != NULL)
+        return data.getInstance()->saveBinary(options.pathCompiled) ? EXIT_SUCCESS : EXIT_FAILURE;
 
-    case VNS:
-        Algorithms::variableSearch(data, count, seed);
-        break;
+    options.settings.timeLimit = options.timeLimit;
 
-    case Genetic:
-        Algorithms::genetic(data, size, count, scheme, seed);
-        break;
+    // A resumed search keeps saving to its checkpoint, unless told otherwise
 
-    case Memetic:
-        Algorithms::memetic(data, size, count, hybridization, seed);
-        break;
+    if (options.pathCheckpoint != NULL || options.pathResume != NULL) {
+        const char *path = options.pathCheckpoint != NULL ? options.pathCheckpoint : options.pathResume;
+        checkpoint.reset(new Algorithms::Checkpoint(path, options.checkpointInterval, options.settings));
 
-    case ParallelSA:
-        Algorithms::parallelAnnealing(data, processes, count, migrLatency, seed);
-        break;
+        if (options.pathResume != NULL) {
+            if (!checkpoint->load(options.pathResume, data))
+                return EXIT_FAILURE;
 
-    case ParallelGenetic:
-        Algorithms::parallelGenetic(data, processes, size, count, migrLatency, topology, seed);
+            options.settings = checkpoint->getSettings();
+            checkpoint->getStart(data);
+        } else if (!Algorithms::Checkpoint::supports(options.settings.algorithm)) {
+            cerr << "Checkpoints need one of the algorithms sa, ga, ma, psa or pga.\n";
+            return EXIT_FAILURE;
+        }
     }
 
+    const unsigned long interruptions = Algorithms::Deadline::interruptions();
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    // With an algorithm, the tour is where the search starts
+
+    if (options.pathTOUR_in != NULL && options.pathResume != NULL) {
+        cerr << "A resumed search starts from the tour saved in its checkpoint.\n";
+        return EXIT_FAILURE;
+    } else if (options.pathTOUR_in != NULL) {
+        if (!data.loadTour(options.pathTOUR_in))
+            return EXIT_FAILURE;
+
+        options.settings.warmStart = true;
+    } else if (options.settings.algorithm == Algorithms::None) {
+        cerr << "Nothing to do...\n";
+        return EXIT_FAILURE;
+    } else if (options.startBest && options.pathResume == NULL && results->best(data))
+        options.settings.warmStart = true;
+
+    w0 = std::chrono::steady_clock::now();
+    t0 = clock();
+
+    if (results && options.settings.algorithm != Algorithms::None) {
+        key = Tsp::ResultCache::key(data, options.settings);
+        cached = results->lookup(key, data);
+    }
+
+    // A signal may have come before the search
+
+    if (!cached && Algorithms::Deadline::interruptions() == interruptions)
+        Algorithms::solve(data, options.settings, checkpoint.get());
+
+    const bool interrupted = Algorithms::Deadline::interruptions() != interruptions;
+
     t1 = clock();
+    w1 = std::chrono::steady_clock::now();
 
-    if (pathTOUR_out != NULL)
-        data.saveTour(pathTOUR_out);
+    if (interrupted)
+        cerr << "Interrupted: keeping the best tour found so far.\n";
+    else if (cached)
+        cerr << "Result taken from the cache.\n";
+
+    // Only complete searches are stored, as a time limit changes the result
+
+    if (results && !cached && options.settings.algorithm != Algorithms::None && options.settings.timeLimit == 0 && !interrupted)
+        results->store(key, data);
+
+    if (options.pathTOUR_out != NULL)
+        data.saveTour(options.pathTOUR_out);
     else {
         cout << "Path:\n";
 
         for (int i = 0; i < data.getSize() - 1; i++)
-            cout << data.edgeAt(i) + 1 << ", ";
+            cout << data.idAt(i) + 1 << ", ";
 
-        cout << data.edgeAt(data.getSize() - 1) + 1 << endl;
+        cout << data.idAt(data.getSize() - 1) + 1 << endl;
     }
 
-    int seconds = round(double(t1 - t0) / CLOCKS_PER_SEC);
-    int minutes = seconds / 60;
-    seconds -= minutes * 60;
+    const long wall = std::chrono::duration_cast<std::chrono::milliseconds>(w1 - w0).count();
+    const long cpu = (long)round(double(t1 - t0) * 1000 / CLOCKS_PER_SEC);
+
+    cout << options.settings.seed << "\t" << data.getCost() << "\t" << wall << " ms\t" << cpu << " ms CPU" << endl;
 
-    cout << seed << "\t" << data.getCost() << "\t" << minutes << ":" << seconds << endl;
+    if (options.memStats)
+        Allocator::printStats(cerr);
 
     return EXIT_SUCCESS;
 }
 
-static bool config(int argc, char **argv)
+static bool config(int argc, char **argv, Options &options)
 {
+    Algorithms::Settings &settings = options.settings;
+
     for (int i = 1; i < argc; i++) {
         if (!strcmp(argv[i], "-a")) {
-            i++;
+            Algorithms::Algorithm algorithm;
 
-            if (!strcmp(argv[i], "greedy")) {
-                algorithm = Greedy;
-                continue;
-            } else if (!strcmp(argv[i], "rs")) {
-                algorithm = RS;
-                count = 2000;
-                continue;
-            } else if (!strcmp(argv[i], "ls")) {
-                algorithm = LS;
-                continue;
-            } else if (!strcmp(argv[i], "vnd")) {
-                algorithm = VND;
-                count = 2000;
-                continue;
-            } else if (!strcmp(argv[i], "sa")) {
-                algorithm = SA;
-                count = 2000;
-                continue;
-            } else if (!strcmp(argv[i], "greedyls")) {
-                algorithm = GreedyLS;
-                continue;
-            } else if (!strcmp(argv[i], "greedyls+")) {
-                algorithm = GreedyLSExt;
-                count = 5;
-                continue;
-            } else if (!strcmp(argv[i], "bmb")) {
-                algorithm = BMB;
-                count = 50;
-                continue;
-            } else if (!strcmp(argv[i], "grasp")) {
-                algorithm = Grasp;
-                count = 50;
-                continue;
-            } else if (!strcmp(argv[i], "grasp+")) {
-                algorithm = GraspExt;
-                count = 10;
-                continue;
-            } else if (!strcmp(argv[i], "ils")) {
-                algorithm = ILS;
-                count = 50;
-                continue;
-            } else if (!strcmp(argv[i], "vns")) {
-                algorithm = VNS;
-                count = 50;
-                continue;
-            } else if (!strcmp(argv[i], "ga")) {
-                algorithm = Genetic;
-                count = 2000;
-                size = 30;
-                continue;
-            } else if (!strcmp(argv[i], "ma")) {
-                algorithm = Memetic;
-                count = 2000;
-                size = 10;
-                continue;
-            } else if (!strcmp(argv[i], "psa")) {
-                algorithm = ParallelSA;
-                count = 20;
-                processes = 5;
-                continue;
-            } else if (!strcmp(argv[i], "pga")) {
-                algorithm = ParallelGenetic;
-                count = 50;
-                size = 10;
-                migrLatency = 2;
-                processes = 4;
-                continue;
-            }
-
-            else
+            if (++i == argc || !Algorithms::parse(argv[i], algorithm))
                 return false;
+
+            settings = Algorithms::Settings(algorithm, settings.seed);
+            continue;
         } else if (!strcmp(argv[i], "-n")) {
-            if (algorithm == None)
+            if (settings.algorithm == Algorithms::None)
                 return false;
 
-            count = strtol(argv[++i], NULL, 10);
+            settings.count = strtol(argv[++i], NULL, 10);
             continue;
         } else if (!strcmp(argv[i], "-s")) {
-            if (algorithm == None)
+            if (settings.algorithm == Algorithms::None)
                 return false;
 
-            seed = strtoul(argv[++i], NULL, 10);
+            settings.seed = strtoul(argv[++i], NULL, 10);
             continue;
         } else if (!strcmp(argv[i], "-d")) {
-            if (algorithm == None)
+            if (settings.algorithm == Algorithms::None)
                 return false;
 
-            size = strtol(argv[++i], NULL, 10);
+            settings.size = strtol(argv[++i], NULL, 10);
             continue;
         } else if (!strcmp(argv[i], "-p")) {
-            if (algorithm == None)
+            if (settings.algorithm == Algorithms::None)
                 return false;
 
-            processes = strtol(argv[++i], NULL, 10);
+            settings.processes = strtol(argv[++i], NULL, 10);
             continue;
         } else if (!strcmp(argv[i], "-l")) {
-            if (algorithm == None)
+            if (settings.algorithm == Algorithms::None)
                 return false;
 
-            migrLatency = strtol(argv[++i], NULL, 10);
+            settings.migrLatency = strtol(argv[++i], NULL, 10);
             continue;
         } else if (!strcmp(argv[i], "-m")) {
-            if (algorithm != SA)
+            if (settings.algorithm != Algorithms::SA)
                 return false;
 
-            i++;
-
-            if (!strcmp(argv[i], "swap")) {
-                generator = Algorithms::Swap;
-                continue;
-            } else if (!strcmp(argv[i], "invert")) {
-                generator = Algorithms::Invert;
-                continue;
-            } else
+            if (++i == argc || !Algorithms::parse(argv[i], settings.neighbor))
                 return false;
+
+            continue;
         } else if (!strcmp(argv[i], "-c")) {
             if (i + 1 < argc) {
-                pathTOUR_in = argv[++i];
+                options.pathTOUR_in = argv[++i];
                 continue;
             } else
                 return false;
         } else if (!strcmp(argv[i], "-o")) {
             if (i + 1 < argc) {
-                pathTOUR_out = argv[++i];
+                options.pathTOUR_out = argv[++i];
                 continue;
             } else
                 return false;
         } else if (!strcmp(argv[i], "-g")) {
-            if (algorithm != Genetic)
+            if (settings.algorithm != Algorithms::Genetic)
+                return false;
+
+            if (++i == argc || !Algorithms::parse(argv[i], settings.scheme))
                 return false;
 
-            i++;
+            continue;
+        } else if (!strcmp(argv[i], "-x")) {
+            if (settings.algorithm != Algorithms::Genetic && settings.algorithm != Algorithms::Memetic && settings.algorithm != Algorithms::ParallelGenetic)
+                return false;
 
-            if (!strcmp(argv[i], "gener")) {
-                scheme = Algorithms::Generational;
+            if (++i == argc || !Algorithms::parse(argv[i], settings.crossover))
+                return false;
+
+            continue;
+        } else if (!strcmp(argv[i], "-h")) {
+            if (settings.algorithm != Algorithms::Memetic)
+                return false;
+
+            if (++i == argc || !Algorithms::parse(argv[i], settings.hybridization))
+                return false;
+
+            continue;
+        } else if (!strcmp(argv[i], "-t")) {
+            if (settings.algorithm != Algorithms::ParallelGenetic)
+                return false;
+
+            if (++i == argc || !Algorithms::parse(argv[i], settings.topology))
+                return false;
+
+            continue;
+        } else if (!strcmp(argv[i], "--layout")) {
+            if (++i == argc)
+                return false;
+
+            if (!strcmp(argv[i], "packed")) {
+                options.layout = Instance::Packed;
                 continue;
-            } else if (!strcmp(argv[i], "stat")) {
-                scheme = Algorithms::Stationary;
+            } else if (!strcmp(argv[i], "square")) {
+                options.layout = Instance::Square;
+                continue;
+            } else if (!strcmp(argv[i], "tiled")) {
+                options.layout = Instance::Tiled;
                 continue;
             } else
                 return false;
-        } else if (!strcmp(argv[i], "-h")) {
-            if (algorithm != Memetic)
+        } else if (!strcmp(argv[i], "--order")) {
+            if (++i == argc)
                 return false;
 
-            i++;
-
-            if (!strcmp(argv[i], "all,2")) {
-                hybridization = Algorithms::Everygen_Twochrom;
+            if (!strcmp(argv[i], "original")) {
+                options.order = Instance::Original;
                 continue;
-            } else if (!strcmp(argv[i], "all,all")) {
-                hybridization = Algorithms::Everygen_Everychrom;
+            } else if (!strcmp(argv[i], "hilbert")) {
+                options.order = Instance::Hilbert;
                 continue;
-            } else if (!strcmp(argv[i], "10,2")) {
-                hybridization = Algorithms::Tengen_Twochrom;
+            } else
+                return false;
+        } else if (!strcmp(argv[i], "--pages")) {
+            if (++i == argc)
+                return false;
+
+            if (!strcmp(argv[i], "normal")) {
+                options.pages = Allocator::Normal;
                 continue;
-            } else if (!strcmp(argv[i], "10,all")) {
-                hybridization = Algorithms::Tengen_Everychrom;
+            } else if (!strcmp(argv[i], "transparent")) {
+                options.pages = Allocator::Transparent;
+                continue;
+            } else if (!strcmp(argv[i], "explicit")) {
+                options.pages = Allocator::Explicit;
                 continue;
             } else
                 return false;
-        } else if (!strcmp(argv[i], "-t")) {
-            if (algorithm != ParallelGenetic)
+        } else if (!strcmp(argv[i], "--first-touch")) {
+            options.firstTouch = true;
+            continue;
+        } else if (!strcmp(argv[i], "--mem-stats")) {
+            options.memStats = true;
+            continue;
+        } else if (!strcmp(argv[i], "--time-limit")) {
+            if (++i == argc)
+                return false;
+
+            options.timeLimit = (long)(strtod(argv[i], NULL) * 1000);
+
+            if (options.timeLimit <= 0)
+                return false;
+
+            continue;
+        } else if (!strcmp(argv[i], "--checkpoint")) {
+            if (++i == argc)
+                return false;
+
+            options.pathCheckpoint = argv[i];
+            continue;
+        } else if (!strcmp(argv[i], "--checkpoint-interval")) {
+            if (++i == argc)
                 return false;
 
-            i++;
+            options.checkpointInterval = (long)(strtod(argv[i], NULL) * 1000);
 
-            if (!strcmp(argv[i], "star")) {
-                topology = Algorithms::Star;
+            if (options.checkpointInterval <= 0)
+                return false;
+
+            continue;
+        } else if (!strcmp(argv[i], "--resume")) {
+            if (++i == argc)
+                return false;
+
+            options.pathResume = argv[i];
+            continue;
+        } else if (!strcmp(argv[i], "--result-cache")) {
+            if (++i == argc)
+                return false;
+
+            options.pathResults = argv[i];
+            continue;
+        } else if (!strcmp(argv[i], "--result-cache-size")) {
+            if (++i == argc)
+                return false;
+
+            options.resultsCapacity = strtol(argv[i], NULL, 10) << 20;
+
+            if (options.resultsCapacity <= 0)
+                return false;
+
+            continue;
+        } else if (!strcmp(argv[i], "--start-best")) {
+            options.startBest = true;
+            continue;
+        } else if (!strcmp(argv[i], "--matrix")) {
+            if (++i == argc)
+                return false;
+
+            options.matrix = true;
+
+            if (!strcmp(argv[i], "float32")) {
+                options.weight = Instance::Float32;
                 continue;
-            } else if (!strcmp(argv[i], "ring")) {
-                topology = Algorithms::Ring;
+            } else if (!strcmp(argv[i], "int32")) {
+                options.weight = Instance::Int32;
+                continue;
+            } else if (!strcmp(argv[i], "uint16")) {
+                options.weight = Instance::UInt16;
                 continue;
             } else
                 return false;
+        } else if (!strcmp(argv[i], "--compile")) {
+            if (++i == argc)
+                return false;
+
+            options.pathCompiled = argv[i];
+            continue;
+        } else if (!strcmp(argv[i], "--daemon")) {
+            options.daemon = true;
+            continue;
+        } else if (!strcmp(argv[i], "--socket")) {
+            if (++i == argc)
+                return false;
+
+            options.daemon = true;
+            options.pathSocket = argv[i];
+            continue;
+        } else if (!strcmp(argv[i], "--batch")) {
+            if (++i == argc)
+                return false;
+
+            options.pathBatch = argv[i];
+            continue;
+        } else if (!strcmp(argv[i], "--workers")) {
+            if (++i == argc)
+                return false;
+
+            options.workers = strtol(argv[i], NULL, 10);
+            continue;
+        } else if (!strcmp(argv[i], "--cache")) {
+            if (++i == argc)
+                return false;
+
+            options.cache = strtol(argv[i], NULL, 10);
+            continue;
         } else if (i == argc - 1)
-            pathTSP = argv[i];
+            options.pathTSP = argv[i];
         else
             return false;
     }
 
-    return (pathTSP != NULL);
+    if (options.startBest && options.pathResults == NULL)
+        return false;
+
+    return (options.pathTSP != NULL || options.daemon || options.pathBatch != NULL);
 }
 
 static void printHelp()
@@ -345,20 +509,44 @@ static void printHelp()
          << endl
          << "Load the TSP file and calculate the cost of a minimum route from a\n"
          << "TOUR file or based on an ALGORITHM implemented in the application.\n"
+         << "The TSP file may also be a binary instance written by --compile.\n"
          << endl
          << "OPTIONS:\n"
-         << "  -a    Apply an ALGORITHM to calculate the cost (overrides -c).\n"
+         << "  -a    Apply an ALGORITHM to calculate the cost.\n"
          << "  -n    Perform the algorithm (REP*n) times or generations. Def: according to the script.\n"
          << "  -s    Set the SEED of the pseudorandom generator. Def: time().\n"
          << "  -m    Use the Neighbor Generation METHOD for Simulated Annealing.\n"
-         << "  -c    Show the cost of the tour saved in the TOUR file.\n"
+         << "  -c    Start the ALGORITHM from the tour in the TOUR file, or show its cost.\n"
          << "  -o    Save the route to a TOUR file instead of displaying it.\n"
          << "  -d    Set the width of the population. Def: according to the script.\n"
          << "  -g    Use the evolutionary SCHEME for genetic algorithms.\n"
+         << "  -x    Use the CROSSOVER operator for genetic and memetic algorithms.\n"
          << "  -h    Select the HYBRIDIZATION type for memetic algorithms.\n"
          << "  -p    Specify the number of parallel processes. Def: according to the script.\n"
          << "  -l    Change the migration latency. Def: according to the script.\n"
          << "  -t    Follow a TOPOLOGY in the parallel genetic algorithm.\n"
+         << "  --time-limit SEC Stop the search after SEC seconds of wall time.\n"
+         << "                   SIGINT and SIGTERM also stop it, keeping the best tour.\n"
+         << "  --checkpoint FILE  Save the state of the search (sa, ga, ma, psa, pga) to FILE\n"
+         << "                   periodically and when it stops.\n"
+         << "  --checkpoint-interval SEC  Time between checkpoints. Def: 60.\n"
+         << "  --resume FILE    Continue the search saved in FILE, with its settings.\n"
+         << "  --result-cache DIR  Reuse the results of identical solves, stored in DIR.\n"
+         << "  --result-cache-size MB  Maximum size of the result cache. Def: 256.\n"
+         << "  --start-best     Start from the best tour of the result cache (no -c).\n"
+         << "  --layout LAYOUT  Storage of the distance matrix.\n"
+         << "  --order ORDER    Numbering of the cities in memory.\n"
+         << "  --pages PAGES    Page size for large buffers.\n"
+         << "  --first-touch    Interleave the pages of large buffers over the NUMA nodes\n"
+         << "                   (best effort, from threads pinned to each node).\n"
+         << "  --mem-stats      Print allocation statistics on exit.\n"
+         << "  --matrix TYPE    The TSP file is a raw square matrix of TYPE cells.\n"
+         << "  --compile FILE   Save the loaded instance as a binary FILE and exit.\n"
+         << "  --daemon         Serve solve requests from the standard input (no TSP).\n"
+         << "  --socket PATH    Serve solve requests on a Unix domain socket (no TSP).\n"
+         << "  --batch FILE     Run the jobs of a manifest FILE (\"-\" for stdin, no TSP).\n"
+         << "  --workers N      Threads of the daemon or the batch. Def: number of cores.\n"
+         << "  --cache N        Problems kept loaded by the daemon. Def: 64.\n"
          << endl
          << "ALGORITHMS:\n"
          << "  greedy    Greedy search\n"
@@ -390,6 +578,13 @@ static void printHelp()
          << "  gener    Generational [default]\n"
          << "  stat     Stationary\n"
          << endl
+         << "CROSSOVER OPERATORS:\n"
+         << "  segment  Reorder a segment of the father as in the mother [default]\n"
+         << "  ox       Order crossover\n"
+         << "  pmx      Partially mapped crossover\n"
+         << "  eax      Edge assembly crossover, one AB-cycle per child\n"
+         << "  eax-block  Edge assembly crossover, blocks of adjacent AB-cycles\n"
+         << endl
          << "TYPES OF HYBRIDATION:\n"
          << "  all,2    All generations, on the 2 best chromosomes\n"
          << "  all,all  All generations, over all chromosomes [default]\n"
@@ -398,5 +593,33 @@ static void printHelp()
          << endl
          << "TOPOLOGY MODELS:\n"
          << "  star     Star\n"
-         << "  ring     Ring [default]\n";
+         << "  ring     Ring [default]\n"
+         << endl
+         << "MATRIX LAYOUTS:\n"
+         << "  packed   Lower triangle [default]\n"
+         << "  square   Full matrix\n"
+         << "  tiled    Full matrix in 16x16 tiles\n"
+         << endl
+         << "CITY ORDERS:\n"
+         << "  original Order of the TSP file [default]\n"
+         << "  hilbert  Along a Hilbert curve\n"
+         << endl
+         << "MATRIX TYPES (native byte order, row by row):\n"
+         << "  float32  32-bit floating point\n"
+         << "  int32    32-bit signed integer\n"
+         << "  uint16   16-bit unsigned integer\n"
+         << endl
+         << "PAGE SIZES:\n"
+         << "  normal       Regular pages [default]\n"
+         << "  transparent  Transparent huge pages\n"
+         << "  explicit     Reserved huge pages (transparent if unavailable)\n"
+         << endl
+         << "DAEMON REQUESTS (one per line):\n"
+         << "  solve [id=ID] (tsp=PATH | points=X,Y;X,Y;...) [algorithm=NAME] [count=N]\n"
+         << "        [seed=N] [size=N] [processes=N] [latency=N] [neighbor=NAME]\n"
+         << "        [scheme=NAME] [crossover=NAME] [hybridization=NAME] [topology=NAME]\n"
+         << "        [time-limit=SECONDS]\n"
+         << "  stats\n"
+         << "  quit\n"
+         << "  Answers: \"ID ok COST MILLISECONDS NODE...\" or \"ID error MESSAGE\".\n";
 }
@@ -2,46 +2,167 @@
 
 #include "population.h"
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include "checkpoint.h"
+
+#define OPTIMA_SHARE 16 ///< Slots of the table of local optima per chromosome
 
 using namespace std;
 
 namespace Algorithms
 {
 
-void memetic(Cycle &data, int size, int count, Hybridization hybridization, unsigned int seed)
+/**
+ * @brief Local search over a chromosome
+ * @param population Population that holds the chromosome.
+ * @param index Index of the chromosome.
+ * @param optima Hashes of the tours last returned by the local search.
+ * @param deadline Budget of the search.
+ *
+ * Tours that are known local optima are skipped, as the search would only
+ * spend a full neighborhood to find nothing. The table is direct-mapped by
+ * the low bits of the hash, so a new optimum evicts the one in its slot and
+ * the memory stays bounded, however long the search runs.
+ *
+ * @return Number of evaluations.
+ */
+static int improve(Population &population, int index, vector<uint64_t> &optima, Deadline &deadline)
+{
+    const size_t mask = optima.size() - 1;
+    uint64_t hash = population.hashOf(index);
+
+    if (hash != 0 && optima[hash & mask] == hash)
+        return 0;
+
+    int evals = localSearch(population.at(index), deadline);
+    population.update(index);
+    hash = population.hashOf(index);
+    optima[hash & mask] = hash;
+    return evals;
+}
+
+/**
+ * @brief Serialize the state of the memetic algorithm
+ * @param checkpoint Destination, to be committed by the caller.
+ * @param data Best cycle.
+ * @param population Population.
+ * @param generator Random stream.
+ * @param optima Table of the known local optima.
+ * @param i Evaluations done.
+ * @param nEvolves Generations done.
+ */
+static void stage(Checkpoint &checkpoint, const Cycle &data, const Population &population, const Generator &generator, const vector<uint64_t> &optima, int i, int nEvolves)
+{
+    checkpoint.begin(data);
+    checkpoint.put(i);
+    checkpoint.put(nEvolves);
+    checkpoint.put(generator);
+    checkpoint.put(data);
+    population.save(checkpoint);
+    checkpoint.put((uint64_t)(optima.size() - count(optima.begin(), optima.end(), 0)));
+
+    // Only the filled slots, which are found again from their hash
+
+    for (size_t k = 0; k < optima.size(); k++) {
+        if (optima[k] != 0)
+            checkpoint.put(optima[k]);
+    }
+}
+
+void memetic(Cycle &data, int size, int count, Hybridization hybridization, Crossover crossover, unsigned int seed, bool warm, Deadline &deadline, Checkpoint *checkpoint)
 {
     const int nMax = count * data.getSize();
     int iBest;
+    int i = 0;
     int nEvolves = 0;
     int best1, best2;
+    bool whole = true;
+    bool staged = false;
     Cycle &bestCycle = data;
-    mt19937 generator(seed);
-    Population population(size, data, generator);
+    Generator generator(seed);
+    Population population(size, data, generator, crossover);
+    Population savedPopulation;
+    Generator savedGenerator;
+    Cycle savedBest(data);
+    vector<uint64_t> savedOptima;
+    int savedI = 0;
+    int savedEvolves = 0;
+    size_t nSlots = 1;
+
+    if (warm)
+        population.inject(data);
+
+    while (nSlots < (size_t)size * OPTIMA_SHARE)
+        nSlots *= 2;
+
+    vector<uint64_t> optima(nSlots, 0);
 
     data.setPath(population[population.bestCycle()]);
 
-    for (int i = 0; i < nMax; i += size) {
+    if (checkpoint != NULL && checkpoint->restore()) {
+        uint64_t nOptima, hash;
+
+        checkpoint->get(i);
+        checkpoint->get(nEvolves);
+        checkpoint->get(generator);
+        checkpoint->get(data);
+        population.load(*checkpoint);
+        checkpoint->get(nOptima);
+
+        for (uint64_t k = 0; k < nOptima; k++) {
+            checkpoint->get(hash);
+            optima[hash & (nSlots - 1)] = hash;
+        }
+    }
+
+    // The copy of the state at the start of each generation reuses this storage
+
+    if (checkpoint != NULL) {
+        savedPopulation = population;
+        savedOptima.reserve(nSlots);
+    }
+
+    for (; i < nMax && !deadline.expired(); i += size) {
+        // The state is serialized only when a checkpoint is due. Otherwise it
+        // is copied, so that it can still be saved if the local searches are
+        // stopped halfway through this generation
+
+        if (checkpoint != NULL && checkpoint->due()) {
+            stage(*checkpoint, data, population, generator, optima, i, nEvolves);
+            checkpoint->commit();
+            staged = false;
+        } else if (checkpoint != NULL) {
+            savedPopulation = population;
+            savedGenerator = generator;
+            savedBest.setPath(data);
+            savedOptima = optima;
+            savedI = i;
+            savedEvolves = nEvolves;
+            staged = true;
+        }
+
         population.evolve(Generational);
         nEvolves++;
 
         switch (hybridization) {
         case Everygen_Twochrom:
             population.bestCycles(best1, best2);
-            i += localSearch(population[best1]);
-            i += localSearch(population[best2]);
+            i += improve(population, best1, optima, deadline);
+            i += improve(population, best2, optima, deadline);
             break;
 
         case Everygen_Everychrom:
             for (int j = 0; j < size; j++)
-                i += localSearch(population[j]);
+                i += improve(population, j, optima, deadline);
 
             break;
 
         case Tengen_Twochrom:
             if (nEvolves % 10 == 0) {
                 population.bestCycles(best1, best2);
-                i += localSearch(population[best1]);
-                i += localSearch(population[best2]);
+                i += improve(population, best1, optima, deadline);
+                i += improve(population, best2, optima, deadline);
             }
 
             break;
@@ -49,7 +170,7 @@ void memetic(Cycle &data, int size, int count, Hybridization hybridization, unsi
         case Tengen_Everychrom:
             if (nEvolves % 10 == 0)
                 for (int j = 0; j < size; j++)
-                    i += localSearch(population[j]);
+                    i += improve(population, j, optima, deadline);
         }
 
         iBest = population.bestCycle();
@@ -57,10 +178,27 @@ void memetic(Cycle &data, int size, int count, Hybridization hybridization, unsi
         if (population[iBest].getCost() < bestCycle.getCost())
             bestCycle.setPath(population[iBest]);
 
+        // A local search may have stopped halfway, leaving a state that an
+        // uninterrupted run would never reach: the start of this generation
+        // is saved instead
+
+        if (deadline.expired()) {
+            whole = false;
+            break;
+        }
+
 #ifdef PROFILE
-        cout << i << " / " << nMax << ": " << bestCycle.getCost() << endl;
+        cout << i << " / " << nMax << ": " << bestCycle.getCost() << " (duplicates: " << population.duplicateRate() * 100 << "%)" << endl;
 #endif
     }
+
+    if (checkpoint != NULL && whole) {
+        stage(*checkpoint, data, population, generator, optima, i, nEvolves);
+        checkpoint->commit();
+    } else if (checkpoint != NULL && staged) {
+        stage(*checkpoint, savedBest, savedPopulation, savedGenerator, savedOptima, savedI, savedEvolves);
+        checkpoint->commit();
+    }
 }
 
 }
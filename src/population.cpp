@@ -6,121 +6,366 @@
 
 #include "population.h"
 #include <cfloat>
-#include <set>
+#include <cstring>
+#include <new>
+#include "allocator.h"
+#include "checkpoint.h"
 
 #define PROB_MUTATE 0.1
 #define PROB_CROSS 0.7
-
-std::mt19937 *Population::generator;
+#define SCRATCH 3       ///< Extra rows of the arena (offspring and elite)
+#define INJECT_SHARE 4  ///< One in INJECT_SHARE chromosomes is seeded by inject()
 
 //------------------------------------------------------------------------------
 
 Population::Population()
 {
     size = 0;
+    stride = 0;
+    paths = NULL;
+    costs = NULL;
     chromosomes = NULL;
+    stamps = NULL;
+    positions = NULL;
+    minTree = NULL;
+    maxTree = NULL;
+    indexed = NULL;
+    hashes = NULL;
+    tableKeys = NULL;
+    tableCounts = NULL;
+    eax = NULL;
+    generator = NULL;
+    offspring = 0;
+    duplicates = 0;
+    crossover = Algorithms::Segment;
 }
 
 //------------------------------------------------------------------------------
 
-Population::Population(int size, const Cycle &sample, std::mt19937 &generator)
+Population::Population(int size, const Cycle &sample, Algorithms::Generator &generator, Algorithms::Crossover crossover)
 {
-    this->size = size;
-    chromosomes = new Cycle[size];
+    this->crossover = crossover;
+    this->generator = &generator;
+    eax = NULL;
+    create(size, sample);
 
-    for (int i = 0; i < size; i++) {
-        chromosomes[i] = sample;
+    for (int i = 0; i < size; i++)
         chromosomes[i].shufflePath(generator);
-    }
 
-    Population::generator = &generator;
+    reindex();
 }
 
 //------------------------------------------------------------------------------
 
 Population::Population(const Population &other)
 {
-    size = other.size;
-    chromosomes = new Cycle[other.size];
-
-    for (int i = 0; i < size; i++)
-        chromosomes[i] = other.chromosomes[i];
+    size = 0;
+    stride = 0;
+    paths = NULL;
+    costs = NULL;
+    chromosomes = NULL;
+    stamps = NULL;
+    positions = NULL;
+    minTree = NULL;
+    maxTree = NULL;
+    indexed = NULL;
+    hashes = NULL;
+    tableKeys = NULL;
+    tableCounts = NULL;
+    eax = NULL;
+    generator = other.generator;
+    offspring = other.offspring;
+    duplicates = other.duplicates;
+    crossover = other.crossover;
+
+    if (other.size > 0) {
+        create(other.size, other.chromosomes[0]);
+        memcpy(paths, other.paths, sizeof(int) * size * stride);
+        memcpy(costs, other.costs, sizeof(float) * size);
+        reindex();
+        sum = other.sum;
+    }
 }
 
 //------------------------------------------------------------------------------
 
 Population::~Population()
 {
-    delete [] chromosomes;
+    clear();
 }
 
 //------------------------------------------------------------------------------
 
 Population& Population::operator =(const Population &other)
 {
-    size = other.size;
-    delete [] chromosomes;
-    chromosomes = new Cycle[other.size];
+    if (this == &other)
+        return *this;
 
-    for (int i = 0; i < size; i++)
-        chromosomes[i] = other.chromosomes[i];
+    // The arena is reused if the shape and the instance are the same
+
+    if (size != other.size || crossover != other.crossover || (size > 0 && chromosomes[0].getInstance() != other.chromosomes[0].getInstance())) {
+        clear();
+        crossover = other.crossover;
 
+        if (other.size > 0)
+            create(other.size, other.chromosomes[0]);
+    }
+
+    // Copying through the views also copies their cached hashes, which would
+    // be stale if the rows were copied under them. The running sum is kept, as
+    // reindex() adds the costs in another order
+
+    if (size > 0) {
+        for (int i = 0; i < size; i++)
+            chromosomes[i].setPath(other.chromosomes[i]);
+
+        reindex();
+        sum = other.sum;
+    }
+
+    generator = other.generator;
+    offspring = other.offspring;
+    duplicates = other.duplicates;
     return *this;
 }
 
 //------------------------------------------------------------------------------
 
-int Population::bestCycle() const
+void Population::create(int size, const Cycle &sample)
 {
-    int iBest = 0;
+    const int lineEdges = ALLOC_ALIGNMENT / sizeof(int);
+    const int rows = size + SCRATCH;
+
+    this->size = size;
+    stride = (sample.getSize() + lineEdges - 1) / lineEdges * lineEdges;
+    paths = Allocator::allocate<int>((size_t)rows * stride, true);
+    costs = Allocator::allocate<float>(rows);
+    chromosomes = Allocator::allocate<Cycle>(rows);
+    stamps = Allocator::allocate<unsigned int>(sample.getSize(), true);
+    stamp = 0;
+    positions = Allocator::allocate<int>(sample.getSize());
+
+    for (leaves = 1; leaves < size; leaves *= 2);
+
+    minTree = Allocator::allocate<int>(2 * leaves);
+    maxTree = Allocator::allocate<int>(2 * leaves);
+    indexed = Allocator::allocate<float>(size);
+    hashes = Allocator::allocate<uint64_t>(size);
 
-    for (int i = 1; i < size; i++)
-        if (chromosomes[i].getCost() < chromosomes[iBest].getCost())
-            iBest = i;
+    for (tableMask = 15; tableMask < 2 * size; tableMask = tableMask * 2 + 1);
 
-    return iBest;
+    tableKeys = Allocator::allocate<uint64_t>(tableMask + 1);
+    tableCounts = Allocator::allocate<int>(tableMask + 1, true);
+
+    for (int i = 0; i < rows; i++) {
+        costs[i] = FLT_MAX;
+        new (chromosomes + i) Cycle(sample, paths + (size_t)i * stride, costs + i);
+    }
+
+    if (crossover == Algorithms::EAX || crossover == Algorithms::EAXBlock)
+        eax = new Eax(sample);
 }
 
 //------------------------------------------------------------------------------
 
-void Population::bestCycles(int &iFirst, int &iSecond) const
+void Population::clear()
 {
-    iFirst = 0;
+    if (chromosomes != NULL)
+        for (int i = 0; i < size + SCRATCH; i++)
+            chromosomes[i].~Cycle();
+
+    Allocator::release(chromosomes);
+    Allocator::release(costs);
+    Allocator::release(paths);
+    Allocator::release(stamps);
+    Allocator::release(positions);
+    Allocator::release(minTree);
+    Allocator::release(maxTree);
+    Allocator::release(indexed);
+    Allocator::release(hashes);
+    Allocator::release(tableKeys);
+    Allocator::release(tableCounts);
+    delete eax;
+    chromosomes = NULL;
+    costs = NULL;
+    paths = NULL;
+    stamps = NULL;
+    positions = NULL;
+    minTree = NULL;
+    maxTree = NULL;
+    indexed = NULL;
+    hashes = NULL;
+    tableKeys = NULL;
+    tableCounts = NULL;
+    eax = NULL;
+    size = 0;
+    stride = 0;
+}
 
-    for (int i = 1; i < size; i++)
-        if (chromosomes[i].getCost() < chromosomes[iFirst].getCost())
-            iFirst = i;
+//------------------------------------------------------------------------------
 
-    iSecond = 0;
+void Population::reindex()
+{
+    sum = 0.0;
+    memset(tableCounts, 0, sizeof(int) * (tableMask + 1));
 
-    for (int i = 1; i < size; i++)
-        if (i != iFirst && chromosomes[i].getCost() < chromosomes[iFirst].getCost())
-            iSecond = i;
+    for (int i = 0; i < leaves; i++) {
+        minTree[leaves + i] = maxTree[leaves + i] = (i < size ? i : -1);
+
+        if (i < size) {
+            indexed[i] = costs[i];
+            sum += costs[i];
+            hashes[i] = chromosomes[i].hash();
+            insertHash(hashes[i]);
+        }
+    }
+
+    for (int k = leaves - 1; k > 0; k--) {
+        minTree[k] = winner(true, minTree[2 * k], minTree[2 * k + 1]);
+        maxTree[k] = winner(false, maxTree[2 * k], maxTree[2 * k + 1]);
+    }
 }
 
 //------------------------------------------------------------------------------
+// Tournament between two chromosomes (or empty leaves, -1). Ties are won by
+// the lowest index, which is always on the left.
 
-int Population::worstCycle() const
+int Population::winner(bool best, int a, int b) const
 {
-    int iWorst = 0;
+    if (a < 0)
+        return b;
 
-    for (int i = 1; i < size; i++)
-        if (chromosomes[i].getCost() > chromosomes[iWorst].getCost())
-            iWorst = i;
+    if (b < 0)
+        return a;
 
-    return iWorst;
+    if (best)
+        return indexed[b] < indexed[a] ? b : a;
+    else
+        return indexed[b] > indexed[a] ? b : a;
 }
 
 //------------------------------------------------------------------------------
 
-float Population::meanCost() const
+void Population::update(int index)
 {
-    float cost = 0.0;
+    uint64_t hash = chromosomes[index].hash();
 
-    for (int i = 0; i < size; i++)
-        cost += chromosomes[i].getCost();
+    if (hash != hashes[index]) {
+        eraseHash(hashes[index]);
+        insertHash(hash);
+        hashes[index] = hash;
+    }
+
+    sum += (double)costs[index] - indexed[index];
+    indexed[index] = costs[index];
+
+    for (int k = (leaves + index) / 2; k > 0; k /= 2) {
+        minTree[k] = winner(true, minTree[2 * k], minTree[2 * k + 1]);
+        maxTree[k] = winner(false, maxTree[2 * k], maxTree[2 * k + 1]);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Hash table with linear probing. Equal chromosomes share an entry, with the
+// number of copies as its count.
+
+bool Population::contains(uint64_t hash) const
+{
+    for (int k = hash & tableMask; tableCounts[k] > 0; k = (k + 1) & tableMask)
+        if (tableKeys[k] == hash)
+            return true;
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
+void Population::insertHash(uint64_t hash)
+{
+    int k = hash & tableMask;
+
+    while (tableCounts[k] > 0 && tableKeys[k] != hash)
+        k = (k + 1) & tableMask;
+
+    tableKeys[k] = hash;
+    tableCounts[k]++;
+}
+
+//------------------------------------------------------------------------------
+// When an entry is emptied, the following entries of its cluster are shifted
+// back if their home slot allows it, so that no probe sequence is broken.
+
+void Population::eraseHash(uint64_t hash)
+{
+    int k = hash & tableMask;
+
+    while (tableKeys[k] != hash)
+        k = (k + 1) & tableMask;
+
+    if (--tableCounts[k] > 0)
+        return;
+
+    for (int j = (k + 1) & tableMask; tableCounts[j] > 0; j = (j + 1) & tableMask) {
+        int home = tableKeys[j] & tableMask;
+
+        // Move j to k if home is not cyclically in ]k, j]
+
+        if ((j > k && (home <= k || home > j)) || (j < k && (home <= k && home > j))) {
+            tableKeys[k] = tableKeys[j];
+            tableCounts[k] = tableCounts[j];
+            tableCounts[j] = 0;
+            k = j;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Check whether a child is already in the population (or equal to its
+// sibling, that is about to be inserted).
+
+bool Population::duplicated(const Cycle &child, const Cycle *sibling)
+{
+    uint64_t hash = child.hash();
+
+    offspring++;
+
+    if (contains(hash) || (sibling != NULL && sibling->hash() == hash)) {
+        duplicates++;
+        return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
+float Population::duplicateRate() const
+{
+    return offspring > 0 ? (float)duplicates / offspring : 0.0;
+}
+
+//------------------------------------------------------------------------------
+
+void Population::setPath(int index, const Cycle &source)
+{
+    chromosomes[index].setPath(source);
+    update(index);
+}
+
+//------------------------------------------------------------------------------
+// The second best lost a tournament against the best one, so it is the best of
+// the rivals on the path from the root to the best leaf.
+
+void Population::bestCycles(int &iFirst, int &iSecond) const
+{
+    iFirst = minTree[1];
+    iSecond = -1;
 
-    return cost / size;
+    for (int k = leaves + iFirst; k > 1; k /= 2)
+        iSecond = winner(true, iSecond, minTree[k ^ 1]);
+
+    if (iSecond < 0)
+        iSecond = iFirst;
 }
 
 //------------------------------------------------------------------------------
@@ -130,13 +375,13 @@ void Population::evolve(Algorithms::Scheme scheme)
     int iFather;
     int iMother;
     int iWorst;
-    Cycle soon;
-    Cycle daughter;
-    Cycle best;
+    Cycle &soon = chromosomes[size];
+    Cycle &daughter = chromosomes[size + 1];
+    Cycle &best = chromosomes[size + 2];
 
     switch (scheme) {
     case Algorithms::Generational:
-        best = chromosomes[bestCycle()];
+        best.setPath(chromosomes[bestCycle()]);
 
         for (int iLast = size; iLast > 2; iLast -= 2) {
             iFather = select(iLast);
@@ -146,8 +391,8 @@ void Population::evolve(Algorithms::Scheme scheme)
             } while (iFather == iMother);
 
             if (crossNow()) {
-                soon = cross(iFather, iMother);
-                daughter = cross(iMother, iFather);
+                cross(iFather, iMother, soon);
+                cross(iMother, iFather, daughter);
             } else {
                 soon.setPath(chromosomes[iFather]);
                 daughter.setPath(chromosomes[iMother]);
@@ -161,13 +406,23 @@ void Population::evolve(Algorithms::Scheme scheme)
                 daughter.shuffleSubpath(daughter.getSize() / 8, *generator);
             }
 
+            // Clones are mutated instead of filling the population
+
+            if (duplicated(soon)) {
+                soon.shuffleSubpath(soon.getSize() / 8, *generator);
+            }
+
+            if (duplicated(daughter, &soon)) {
+                daughter.shuffleSubpath(daughter.getSize() / 8, *generator);
+            }
+
             replace(iFather, iMother, soon, daughter, iLast);
         }
 
         iWorst = worstCycle();
 
         if (best.getCost() < chromosomes[iWorst].getCost())
-            chromosomes[iWorst].setPath(best);
+            setPath(iWorst, best);
 
         break;
 
@@ -178,8 +433,8 @@ void Population::evolve(Algorithms::Scheme scheme)
             iMother = select(size);
         } while (iFather == iMother);
 
-        soon = cross(iFather, iMother);
-        daughter = cross(iMother, iFather);
+        cross(iFather, iMother, soon);
+        cross(iMother, iFather, daughter);
 
         if (mutateNow()) {
             soon.shuffleSubpath(soon.getSize() / 8, *generator);
@@ -195,52 +450,195 @@ void Population::evolve(Algorithms::Scheme scheme)
 
 //------------------------------------------------------------------------------
 
+void Population::inject(const Cycle &tour)
+{
+    const int count = size / INJECT_SHARE > 0 ? size / INJECT_SHARE : 1;
+
+    for (int i = 0; i < count; i++) {
+        chromosomes[i].setPath(tour);
+
+        if (i > 0)
+            chromosomes[i].shuffleSubpath(tour.getSize() / 8, *generator);
+    }
+
+    reindex();
+}
+
+//------------------------------------------------------------------------------
+
+void Population::save(Algorithms::Checkpoint &checkpoint) const
+{
+    for (int i = 0; i < size; i++)
+        checkpoint.put(chromosomes[i]);
+
+    checkpoint.put(sum);
+    checkpoint.put(offspring);
+    checkpoint.put(duplicates);
+}
+
+//------------------------------------------------------------------------------
+// The running sum is restored after reindex(), which adds the costs again in a
+// different order than the updates did
+
+void Population::load(Algorithms::Checkpoint &checkpoint)
+{
+    for (int i = 0; i < size; i++)
+        checkpoint.get(chromosomes[i]);
+
+    reindex();
+    checkpoint.get(sum);
+    checkpoint.get(offspring);
+    checkpoint.get(duplicates);
+}
+
+//------------------------------------------------------------------------------
+
 int Population::select(int iLast) const
 {
     int chrom1 = Algorithms::random(*generator, iLast);
     int chrom2 = Algorithms::random(*generator, iLast);
 
-    return chromosomes[chrom1].getCost() < chromosomes[chrom2].getCost() ? chrom1 : chrom2;
+    return costs[chrom1] < costs[chrom2] ? chrom1 : chrom2;
 }
 
 //------------------------------------------------------------------------------
 
-Cycle Population::cross(int iFather, int iMother)
+void Population::cross(int iFather, int iMother, Cycle &child)
 {
     const int n = chromosomes->getSize();
     const Cycle &father = chromosomes[iFather];
     const Cycle &mother = chromosomes[iMother];
 
+    if (eax != NULL) {
+        eax->cross(father, mother, child, crossover == Algorithms::EAXBlock ? Eax::Block : Eax::Single, *generator);
+        return;
+    }
+
     int bound1 = Algorithms::random(*generator, n - 2) + 1;
     int bound2 = Algorithms::random(*generator, n - bound1 - 1) + bound1 + 1;
+
+    switch (crossover) {
+    case Algorithms::Segment:
+        crossSegment(father, mother, bound1, bound2, child);
+        break;
+
+    case Algorithms::OX:
+        crossOX(father, mother, bound1, bound2, child);
+        break;
+
+    case Algorithms::PMX:
+        crossPMX(father, mother, bound1, bound2, child);
+        break;
+
+    case Algorithms::EAX:
+    case Algorithms::EAXBlock:
+        // Dispatched to the Eax object above
+        break;
+    }
+
+    child.updateCost();
+}
+
+//------------------------------------------------------------------------------
+// The child is the father with the segment [bound1, bound2[ reordered as the
+// nodes appear in the mother.
+
+void Population::crossSegment(const Cycle &father, const Cycle &mother, int bound1, int bound2, Cycle &child)
+{
+    const int n = father.getSize();
+    const unsigned int mark = nextStamp();
     int ptr = bound1;
     int edge;
 
-    Cycle soon(chromosomes[iFather]);
-    std::set<int> bounded;
+    child.setPath(father);
 
     for (int i = bound1; i < bound2; i++)
-        bounded.insert(father.edgeAt(i));
+        stamps[father.edgeAt(i)] = mark;
+
+    for (int i = 0; i < n; i++) {
+        edge = mother.edgeAt(i);
+
+        if (stamps[edge] == mark)
+            child.edgeAt(ptr++) = edge;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Order crossover: the child keeps the segment [bound1, bound2[ of the father,
+// and the rest of positions are filled from bound2 onwards with the remaining
+// nodes, in the order they appear in the mother from bound2.
+
+void Population::crossOX(const Cycle &father, const Cycle &mother, int bound1, int bound2, Cycle &child)
+{
+    const int n = father.getSize();
+    const unsigned int mark = nextStamp();
+    int ptr = bound2 % n;
+    int edge;
+
+    for (int i = bound1; i < bound2; i++) {
+        edge = father.edgeAt(i);
+        child.edgeAt(i) = edge;
+        stamps[edge] = mark;
+    }
+
+    for (int i = bound2; i < bound2 + n; i++) {
+        edge = mother.edgeAt(i % n);
+
+        if (stamps[edge] != mark) {
+            child.edgeAt(ptr) = edge;
+            ptr = (ptr + 1) % n;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Partially mapped crossover: the child starts as the mother, and each node of
+// the segment [bound1, bound2[ of the father is swapped into its position.
+
+void Population::crossPMX(const Cycle &father, const Cycle &mother, int bound1, int bound2, Cycle &child)
+{
+    const int n = father.getSize();
+    int edge, from;
 
     for (int i = 0; i < n; i++) {
         edge = mother.edgeAt(i);
+        child.edgeAt(i) = edge;
+        positions[edge] = i;
+    }
+
+    for (int i = bound1; i < bound2; i++) {
+        edge = father.edgeAt(i);
+        from = positions[edge];
+
+        child.edgeAt(from) = child.edgeAt(i);
+        positions[child.edgeAt(from)] = from;
+        child.edgeAt(i) = edge;
+        positions[edge] = i;
+    }
+}
 
-        if (bounded.count(edge))
-            soon.edgeAt(ptr++) = edge;
+//------------------------------------------------------------------------------
+// Mark that identifies the nodes of the current crossover. The marks are only
+// cleared when the counter wraps around.
+
+unsigned int Population::nextStamp()
+{
+    if (++stamp == 0) {
+        memset(stamps, 0, sizeof(unsigned int) * chromosomes->getSize());
+        stamp = 1;
     }
 
-    soon.updateCost();
-    return soon;
+    return stamp;
 }
 
 //------------------------------------------------------------------------------
 
 void Population::replace(int iFather, int iMother, Cycle &soon, Cycle &daughter, int iLast)
 {
-    chromosomes[iFather].setPath(chromosomes[iLast - 2]);
-    chromosomes[iMother].setPath(chromosomes[iLast - 1]);
-    chromosomes[iLast - 2].setPath(soon);
-    chromosomes[iLast - 1].setPath(daughter);
+    setPath(iFather, chromosomes[iLast - 2]);
+    setPath(iMother, chromosomes[iLast - 1]);
+    setPath(iLast - 2, soon);
+    setPath(iLast - 1, daughter);
 }
 
 //------------------------------------------------------------------------------
@@ -249,25 +647,25 @@ void Population::replace(Cycle &soon, Cycle &daughter)
 {
     int iWorst = worstCycle();
 
-    if (chromosomes[iWorst].getCost() > soon.getCost())
-        chromosomes[iWorst].setPath(soon);
+    if (!duplicated(soon) && costs[iWorst] > soon.getCost())
+        setPath(iWorst, soon);
 
     iWorst = worstCycle();
 
-    if (chromosomes[iWorst].getCost() > daughter.getCost())
-        chromosomes[iWorst].setPath(daughter);
+    if (!duplicated(daughter) && costs[iWorst] > daughter.getCost())
+        setPath(iWorst, daughter);
 }
 
 //------------------------------------------------------------------------------
 
 bool Population::mutateNow()
 {
-    return (double)(*generator)() / generator->max() <= PROB_MUTATE;
+    return Algorithms::uniform(*generator) <= PROB_MUTATE;
 }
 
 //------------------------------------------------------------------------------
 
 bool Population::crossNow()
 {
-    return (double)(*generator)() / generator->max() <= PROB_CROSS;
+    return Algorithms::uniform(*generator) <= PROB_CROSS;
 }
@@ -9,47 +9,163 @@
 
 #include "cycle.h"
 #include "algorithms.h"
+#include "eax.h"
 
+/**
+ * @brief Population Class
+ *
+ * Set of chromosomes for evolutionary algorithms. The paths of all the
+ * chromosomes lie back to back in a single arena, one per cache-aligned row,
+ * and their costs in a separate array. Each chromosome is presented as a Cycle
+ * view over its row.
+ *
+ * A few extra rows hold the offspring and the elite of a generation, so that
+ * evolve() does not allocate any memory.
+ *
+ * Two tournament trees over the costs (one for the minimum, one for the
+ * maximum) and a running sum answer bestCycle(), worstCycle() and meanCost()
+ * in constant time. Chromosomes must therefore be modified through setPath(),
+ * or through at() followed by update().
+ *
+ * The hash of every chromosome is kept in a small hash table, so that
+ * offspring identical to a member (in any rotation or direction) are detected
+ * in constant time. Generational replacement mutates them, and stationary
+ * replacement discards them. Cycles cache their hash and update it on swaps
+ * and reversals, so a member improved by a local search is rehashed in O(1).
+ *
+ * Every random choice is drawn from the generator given to the constructor,
+ * which must outlive the population. Populations with different generators
+ * can evolve independently of each other.
+ *
+ * The edge assembly crossovers (EAX and EAXBlock) are delegated to an Eax
+ * engine, created along with the arena.
+ */
 class Population
 {
 public:
 
     Population();
-    explicit Population(int size, const Cycle &sample, std::mt19937 &generator);
+    explicit Population(int size, const Cycle &sample, Algorithms::Generator &generator, Algorithms::Crossover crossover = Algorithms::Segment);
     Population(const Population&);
     ~Population();
 
     Population& operator =(const Population &other);
 
-    inline Cycle& operator [](int index)
+    inline const Cycle& operator [](int index) const
+    {
+        return chromosomes[index];
+    }
+
+    /**
+     * @brief Modifiable chromosome
+     * @param index Index of the chromosome.
+     * @post update() must be called after modifying it.
+     * @return Reference to the chromosome.
+     */
+    inline Cycle& at(int index)
     {
         return chromosomes[index];
     }
 
+    void update(int index);
+    void setPath(int index, const Cycle &source);
+
     inline int getSize() const
     {
         return size;
     }
 
-    int bestCycle() const;
+    inline int bestCycle() const
+    {
+        return minTree[1];
+    }
+
+    inline int worstCycle() const
+    {
+        return maxTree[1];
+    }
+
+    inline float meanCost() const
+    {
+        return (float)(sum / size);
+    }
+
     void bestCycles(int &iFirst, int &iSecond) const;
-    int worstCycle() const;
-    float meanCost() const;
+
+    inline uint64_t hashOf(int index) const
+    {
+        return hashes[index];
+    }
+
+    float duplicateRate() const;
 
     void evolve(Algorithms::Scheme scheme);
 
+    /**
+     * @brief Seed the population with a tour
+     * @param tour Tour to start from.
+     *
+     * The first chromosome becomes @p tour, and a few more become mutations
+     * of it, so that the population keeps its diversity.
+     */
+    void inject(const Cycle &tour);
+
+    /**
+     * @brief Add the chromosomes to a checkpoint
+     * @param checkpoint Checkpoint being built.
+     */
+    void save(Algorithms::Checkpoint &checkpoint) const;
+
+    /**
+     * @brief Read the chromosomes from a checkpoint
+     * @param checkpoint Checkpoint being restored.
+     * @pre The population has the size it had when it was saved.
+     */
+    void load(Algorithms::Checkpoint &checkpoint);
+
 private:
-    int size;
-    Cycle *chromosomes;
-    static std::mt19937 *generator;
+    int size;               ///< Number of chromosomes
+    int stride;             ///< Distance between two paths in the arena
+    int *paths;             ///< Arena of paths
+    float *costs;           ///< Cost of each chromosome
+    Cycle *chromosomes;     ///< Views over the arena
+    unsigned int *stamps;   ///< Crossover mark of each node
+    unsigned int stamp;     ///< Mark of the current crossover
+    int *positions;         ///< Position of each node in a child (PMX)
+    int leaves;             ///< Number of leaves of the trees (power of 2)
+    int *minTree;           ///< Tournament tree of the best chromosomes
+    int *maxTree;           ///< Tournament tree of the worst chromosomes
+    float *indexed;         ///< Cost of each chromosome in the trees
+    double sum;             ///< Sum of the indexed costs
+    uint64_t *hashes;       ///< Hash of each chromosome
+    uint64_t *tableKeys;    ///< Hash table of the chromosomes (keys)
+    int *tableCounts;       ///< Hash table of the chromosomes (0 if empty)
+    int tableMask;          ///< Size of the hash table minus one
+    long offspring;         ///< Number of children produced
+    long duplicates;        ///< Number of children equal to a member
+    Algorithms::Crossover crossover;
+    Eax *eax;               ///< Edge assembly engine (NULL if not needed)
+    Algorithms::Generator *generator;   ///< Random stream of the population
 
+    void create(int size, const Cycle &sample);
+    void clear();
+    void reindex();
+    int winner(bool best, int a, int b) const;
+    bool contains(uint64_t hash) const;
+    void insertHash(uint64_t hash);
+    void eraseHash(uint64_t hash);
+    bool duplicated(const Cycle &child, const Cycle *sibling = NULL);
     int select(int iLast) const;
-    Cycle cross(int iFather, int iMother);
+    void cross(int iFather, int iMother, Cycle &child);
+    void crossSegment(const Cycle &father, const Cycle &mother, int bound1, int bound2, Cycle &child);
+    void crossOX(const Cycle &father, const Cycle &mother, int bound1, int bound2, Cycle &child);
+    void crossPMX(const Cycle &father, const Cycle &mother, int bound1, int bound2, Cycle &child);
+    unsigned int nextStamp();
     void replace(int iFather, int iMother, Cycle &soon, Cycle &daughter, int iLast);
     void replace(Cycle &soon, Cycle &daughter);
 
-    static bool mutateNow();
-    static bool crossNow();
+    bool mutateNow();
+    bool crossNow();
 };
 
 #endif
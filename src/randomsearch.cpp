@@ -9,12 +9,12 @@
 namespace Algorithms
 {
 
-void randomSearch(Cycle &data, int count, unsigned int seed)
+void randomSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline)
 {
     const int MAX = count * data.getSize();
     Cycle curCycle = data;
     Cycle &bestCycle = data;
-    std::mt19937 generator(seed);
+    Generator generator(seed);
 
     /*
      * We generate a random solution (curCycle).
@@ -23,7 +23,7 @@ void randomSearch(Cycle &data, int count, unsigned int seed)
 
     bestCycle.shufflePath(generator);
 
-    for (int i = 1; i < MAX; i++) {
+    for (int i = 1; i < MAX && !deadline.expired(); i++) {
         curCycle.shufflePath(generator);
 
         if (bestCycle.getCost() > curCycle.getCost())
@@ -0,0 +1,263 @@
+/**
+ * @file reader.cpp
+ * @brief Definition of the Reader class
+ * @date October 19, 2026
+ */
+
+#include "reader.h"
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define NUMBER_WIDTH 64     ///< Longest number handed to strtod()
+
+/// Powers of ten that a double holds exactly
+static const double POWERS[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Check for a space or a line break
+ * @param c Character.
+ * @return Whether @p c separates words.
+ */
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Check for a decimal digit
+ * @param c Character.
+ * @return Whether @p c is in [0-9].
+ */
+static inline bool isDigit(char c)
+{
+    return (unsigned char)(c - '0') < 10;
+}
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Reader::Reader()
+{
+    data = NULL;
+    length = 0;
+    cursor = NULL;
+    end = NULL;
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+
+Reader::~Reader()
+{
+    close();
+}
+
+//------------------------------------------------------------------------------
+// Map a file
+
+bool Reader::open(const char *path)
+{
+    struct stat status;
+    int fd = ::open(path, O_RDONLY);
+
+    close();
+
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &status) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = status.st_size;
+
+    if (length > 0) {
+        data = (char *)mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED) {
+            data = NULL;
+            length = 0;
+            ::close(fd);
+            return false;
+        }
+
+        // The file is read once from the start
+
+        madvise(data, length, MADV_SEQUENTIAL);
+    }
+
+    ::close(fd);
+    cursor = data;
+    end = data + length;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Check the first bytes of the file
+
+bool Reader::startsWith(const char *prefix, size_t length) const
+{
+    return this->length >= length && !memcmp(data, prefix, length);
+}
+
+//------------------------------------------------------------------------------
+// Read a line with a keyword
+
+bool Reader::keyword(std::string &key, std::string &value)
+{
+    const char *first, *last;
+
+    while (cursor < end && isSpace(*cursor))
+        cursor++;
+
+    if (cursor == end)
+        return false;
+
+    first = cursor;
+
+    while (cursor < end && *cursor != ':' && !isSpace(*cursor))
+        cursor++;
+
+    key.assign(first, cursor);
+
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+        cursor++;
+
+    if (cursor < end && *cursor == ':')
+        cursor++;
+
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+        cursor++;
+
+    first = cursor;
+
+    while (cursor < end && *cursor != '\n')
+        cursor++;
+
+    last = cursor;
+
+    while (last > first && isSpace(last[-1]))
+        last--;
+
+    value.assign(first, last);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Read a number
+
+bool Reader::number(double &result)
+{
+    const char *p, *start;
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool negative = false, any = false;
+
+    while (cursor < end && isSpace(*cursor))
+        cursor++;
+
+    p = start = cursor;
+
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+
+    /*
+     * Up to 19 significant digits fit in the mantissa, and the rest only scale
+     * it. Leading zeros are not significant.
+     */
+
+    for (; p < end && isDigit(*p); p++, any = true) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += mantissa > 0;
+        } else
+            exponent++;
+    }
+
+    if (p < end && *p == '.') {
+        for (p++; p < end && isDigit(*p); p++, any = true) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa > 0;
+                exponent--;
+            }
+        }
+    }
+
+    if (!any)
+        return false;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool negativeExp = false;
+        int value = 0;
+
+        if (q < end && (*q == '-' || *q == '+'))
+            negativeExp = *q++ == '-';
+
+        if (q < end && isDigit(*q)) {
+            for (; q < end && isDigit(*q); q++)
+                if (value < 10000)
+                    value = value * 10 + (*q - '0');
+
+            exponent += negativeExp ? -value : value;
+            p = q;
+        }
+    }
+
+    if (p < end && !isSpace(*p))
+        return false;
+
+    /*
+     * A mantissa of up to 53 bits scaled by an exact power of ten is rounded
+     * only once, so the result is exact. Otherwise, strtod() is used on a copy
+     * of the number, since the file does not end with a null character.
+     */
+
+    if (mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        result = exponent < 0 ? mantissa / POWERS[-exponent] : mantissa * POWERS[exponent];
+    } else {
+        char buffer[NUMBER_WIDTH];
+
+        if (p - start >= NUMBER_WIDTH)
+            return false;
+
+        memcpy(buffer, start, p - start);
+        buffer[p - start] = '\0';
+        result = strtod(buffer, NULL);
+        negative = false;
+    }
+
+    if (negative)
+        result = -result;
+
+    cursor = p;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Unmap the file
+
+void Reader::close()
+{
+    if (data != NULL)
+        munmap(data, length);
+
+    data = NULL;
+    length = 0;
+    cursor = NULL;
+    end = NULL;
+}
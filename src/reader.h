@@ -0,0 +1,80 @@
+/**
+ * @file reader.h
+ * @brief Declaration of the Reader class
+ * @date October 19, 2026
+ */
+
+#ifndef READER_H
+#define READER_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Reader of TSPLIB text files
+ *
+ * The whole file is mapped into memory and scanned once from the start, so
+ * a header keyword never makes the reader go back, and lines have no length
+ * limit. Numbers are parsed in place, without copying each line.
+ */
+class Reader
+{
+public:
+
+    /// Constructor
+    Reader();
+
+    /// Destructor: unmaps the file
+    ~Reader();
+
+    /**
+     * @brief Map a file
+     * @param path File path.
+     * @return Whether the file could be opened and mapped.
+     */
+    bool open(const char *path);
+
+    /**
+     * @brief Check the first bytes of the file
+     * @param prefix Expected bytes.
+     * @param length Number of bytes.
+     * @return Whether the file starts with @p prefix.
+     */
+    bool startsWith(const char *prefix, size_t length) const;
+
+    /**
+     * @brief Read a line with a keyword
+     * @param key Destination of the keyword (the text before ':' or a space).
+     * @param value Destination of the rest of the line, without ':' and
+     *        surrounding spaces.
+     *
+     * Blank lines are skipped. Sections are keywords with no value.
+     *
+     * @return Whether there was a line left.
+     */
+    bool keyword(std::string &key, std::string &value);
+
+    /**
+     * @brief Read a number
+     * @param result Destination of the number.
+     *
+     * Spaces and line breaks before the number are skipped. If the next word
+     * is not a number, nothing is consumed.
+     *
+     * @return Whether a number was read.
+     */
+    bool number(double &result);
+
+private:
+    char *data;         ///< Mapped file
+    size_t length;      ///< Length of the file
+    const char *cursor; ///< Next character to read
+    const char *end;    ///< End of the file
+
+    Reader(const Reader &);
+    Reader & operator=(const Reader &);
+
+    void close();
+};
+
+#endif /* READER_H */
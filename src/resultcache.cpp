@@ -0,0 +1,349 @@
+/**
+ * @file resultcache.cpp
+ * @brief Definition of the ResultCache class
+ * @date October 19, 2026
+ */
+
+#include "resultcache.h"
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+/// Header of a cached result
+struct ResultHeader {
+    char magic[8];          ///< RESULT_MAGIC
+    uint32_t version;       ///< RESULT_VERSION
+    int32_t nodes;          ///< Number of nodes
+    uint64_t instance;      ///< Content hash of the instance
+    uint64_t key;           ///< Key of the solve (0 for the best tour)
+    float cost;             ///< Cost of the tour, as the search found it
+    uint32_t reserved;      ///< Zero
+    uint64_t checksum;      ///< FNV-1a hash of the nodes
+};
+
+/// Stored file, as seen by evict()
+struct CacheFile {
+    std::string name;       ///< Path of the file
+    off_t size;             ///< Bytes of the file
+    struct timespec used;   ///< Last write or hit
+    bool best;              ///< Whether it is the best tour of an instance
+
+    bool operator<(const CacheFile &other) const
+    {
+        if (best != other.best)
+            return other.best;
+
+        return used.tv_sec < other.used.tv_sec || (used.tv_sec == other.used.tv_sec && used.tv_nsec < other.used.tv_nsec);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Add bytes to a 64-bit FNV-1a hash
+ * @param hash Current value of the hash.
+ * @param data Bytes to add.
+ * @param length Number of bytes.
+ * @return New value of the hash.
+ */
+static uint64_t fnv(uint64_t hash, const void *data, size_t length)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Add a value to a 64-bit FNV-1a hash
+ * @param hash Current value of the hash.
+ * @param value Value to add (widened to 64 bits).
+ * @return New value of the hash.
+ */
+static uint64_t fnv(uint64_t hash, int64_t value)
+{
+    return fnv(hash, &value, sizeof(value));
+}
+
+namespace Tsp
+{
+
+//------------------------------------------------------------------------------
+// Constructor
+
+ResultCache::ResultCache(const char *directory, long capacity)
+{
+    this->directory = directory;
+    this->capacity = capacity;
+}
+
+//------------------------------------------------------------------------------
+// Create the directory
+
+bool ResultCache::open()
+{
+    if (mkdir(directory.c_str(), 0755) < 0 && errno != EEXIST) {
+        std::cerr << "Could not create the cache " << directory << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (access(directory.c_str(), R_OK | W_OK | X_OK) < 0) {
+        std::cerr << "Could not use the cache " << directory << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Key of a solve
+
+uint64_t ResultCache::key(const Cycle &data, const Algorithms::Settings &settings)
+{
+    const Instance &instance = *data.getInstance();
+    uint64_t result = 0xcbf29ce484222325ULL;
+
+    result = fnv(result, RESULT_VERSION);
+    result = fnv(result, (int64_t)instance.getHash());
+
+    // The numbering changes the course of a search with the same seed
+
+    for (int i = 0; i < data.getSize(); i++)
+        result = fnv(result, instance.idOf(i));
+
+    result = fnv(result, settings.algorithm);
+    result = fnv(result, settings.count);
+    result = fnv(result, settings.size);
+    result = fnv(result, settings.processes);
+    result = fnv(result, settings.migrLatency);
+    result = fnv(result, settings.seed);
+    result = fnv(result, settings.neighbor);
+    result = fnv(result, settings.scheme);
+    result = fnv(result, settings.hybridization);
+    result = fnv(result, settings.topology);
+    result = fnv(result, settings.crossover);
+    result = fnv(result, settings.warmStart);
+
+    if (settings.warmStart)
+        for (int i = 0; i < data.getSize(); i++)
+            result = fnv(result, data.edgeAt(i));
+
+    // Zero is the key of the best tours
+
+    return result != 0 ? result : 1;
+}
+
+//------------------------------------------------------------------------------
+// Fetch a stored result
+
+bool ResultCache::lookup(uint64_t key, Cycle &data) const
+{
+    const std::string path = pathOf("", key);
+
+    if (!read(path, key, data))
+        return false;
+
+    // Recently used entries are the last to be evicted
+
+    utimensat(AT_FDCWD, path.c_str(), NULL, 0);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Store a result
+
+void ResultCache::store(uint64_t key, const Cycle &data)
+{
+    const std::string best = pathOf("best-", data.getInstance()->getHash());
+    const int lock = ::open((directory + "/lock").c_str(), O_RDWR | O_CREAT, 0644);
+    Cycle known(data);
+
+    write(pathOf("", key), key, data);
+
+    if (lock < 0 || flock(lock, LOCK_EX) < 0) {
+        std::cerr << "Could not lock the cache " << directory << ": " << strerror(errno) << std::endl;
+
+        if (lock >= 0)
+            close(lock);
+
+        return;
+    }
+
+    if (!read(best, 0, known) || data.getCost() < known.getCost())
+        write(best, 0, data);
+
+    evict();
+    close(lock);
+}
+
+//------------------------------------------------------------------------------
+// Fetch the best known tour of an instance
+
+bool ResultCache::best(Cycle &data) const
+{
+    const std::string path = pathOf("best-", data.getInstance()->getHash());
+
+    if (!read(path, 0, data))
+        return false;
+
+    utimensat(AT_FDCWD, path.c_str(), NULL, 0);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Path of an entry
+
+std::string ResultCache::pathOf(const char *prefix, uint64_t key) const
+{
+    char name[32];
+
+    snprintf(name, sizeof(name), "%016llx.tour", (unsigned long long)key);
+    return directory + "/" + prefix + name;
+}
+
+//------------------------------------------------------------------------------
+// Read an entry, checking that it belongs to the instance
+
+bool ResultCache::read(const std::string &path, uint64_t key, Cycle &data) const
+{
+    ResultHeader header;
+    std::vector<int32_t> ids(data.getSize());
+    const size_t length = sizeof(int32_t) * ids.size();
+    ssize_t count;
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    count = ::read(fd, &header, sizeof(header));
+
+    if (count == (ssize_t)sizeof(header) && header.nodes == data.getSize())
+        count = ::read(fd, ids.data(), length);
+    else
+        count = -1;
+
+    close(fd);
+
+    if (count != (ssize_t)length || memcmp(header.magic, RESULT_MAGIC, sizeof(header.magic)) || header.version != RESULT_VERSION)
+        return false;
+
+    if (header.instance != data.getInstance()->getHash() || header.key != key || header.checksum != fnv(0xcbf29ce484222325ULL, ids.data(), length))
+        return false;
+
+    Cycle tour(data);
+
+    if (!tour.setTour(ids.data(), (int)ids.size()))
+        return false;
+
+    // Keep the cost as the search found it, which may differ in the last bits
+    data.setPath(&tour.edgeAt(0), header.cost);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Write an entry under a temporary name and rename it
+
+bool ResultCache::write(const std::string &path, uint64_t key, const Cycle &data) const
+{
+    ResultHeader header;
+    std::vector<int32_t> ids(data.getSize());
+    std::string temporary = path + ".XXXXXX";
+    bool done;
+    int fd;
+
+    for (int i = 0; i < data.getSize(); i++)
+        ids[i] = data.idAt(i);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RESULT_MAGIC, sizeof(header.magic));
+    header.version = RESULT_VERSION;
+    header.nodes = data.getSize();
+    header.instance = data.getInstance()->getHash();
+    header.key = key;
+    header.cost = data.getCost();
+    header.checksum = fnv(0xcbf29ce484222325ULL, ids.data(), sizeof(int32_t) * ids.size());
+
+    fd = mkstemp(&temporary[0]);
+
+    if (fd < 0) {
+        std::cerr << "Could not write to the cache " << directory << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    fchmod(fd, 0644);
+    done = ::write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+    done = done && ::write(fd, ids.data(), sizeof(int32_t) * ids.size()) == (ssize_t)(sizeof(int32_t) * ids.size());
+    close(fd);
+
+    if (!done || rename(temporary.c_str(), path.c_str()) < 0) {
+        std::cerr << "Could not write to the cache " << directory << ": " << strerror(errno) << std::endl;
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Remove the least recently used entries over the capacity
+
+void ResultCache::evict() const
+{
+    std::vector<CacheFile> files;
+    long total = 0;
+    struct dirent *entry;
+    struct stat status;
+    DIR *dir = opendir(directory.c_str());
+
+    if (dir == NULL)
+        return;
+
+    while ((entry = readdir(dir)) != NULL) {
+        const size_t length = strlen(entry->d_name);
+        CacheFile file;
+
+        if (length < 5 || strcmp(entry->d_name + length - 5, ".tour"))
+            continue;
+
+        file.name = directory + "/" + entry->d_name;
+
+        if (stat(file.name.c_str(), &status) < 0)
+            continue;
+
+        file.size = status.st_size;
+        file.used = status.st_mtim;
+        file.best = !strncmp(entry->d_name, "best-", 5);
+        total += file.size;
+        files.push_back(file);
+    }
+
+    closedir(dir);
+
+    if (total <= capacity)
+        return;
+
+    // Best tours are the last to go, as they cannot be found again cheaply
+
+    std::sort(files.begin(), files.end());
+
+    for (size_t i = 0; i < files.size() && total > capacity; i++) {
+        if (unlink(files[i].name.c_str()) == 0)
+            total -= files[i].size;
+    }
+}
+
+}
@@ -0,0 +1,100 @@
+/**
+ * @file resultcache.h
+ * @brief Declaration of the ResultCache class
+ * @date October 19, 2026
+ */
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <string>
+#include "cycle.h"
+#include "solver.h"
+
+#define RESULT_MAGIC "TSPRES\r\n"  ///< First bytes of a cached result
+#define RESULT_VERSION 1            ///< Version of the cached results
+
+namespace Tsp
+{
+
+/**
+ * @brief ResultCache Class
+ *
+ * Directory of solved problems, shared by any number of processes. Each
+ * result is a file named after a hash of the instance content, the numbering
+ * of its nodes, the settings of the search (seed included) and the starting
+ * tour, if any. It holds the tour, in original node numbers, and its cost.
+ *
+ * The best tour ever stored for an instance is also kept apart, whatever the
+ * settings, so that a later search can start from it.
+ *
+ * Files are written to a temporary name and renamed, so readers never see a
+ * partial result. Updates of the best tours and evictions hold an exclusive
+ * lock on a file of the directory. When the directory grows over its
+ * capacity, the least recently used results are removed (the best tours
+ * only when no other file is left).
+ */
+class ResultCache
+{
+public:
+
+    /**
+     * @brief Constructor
+     * @param directory Directory of the cache (created if it does not exist).
+     * @param capacity Maximum bytes of the stored files.
+     */
+    ResultCache(const char *directory, long capacity);
+
+    /**
+     * @brief Create the directory
+     * @return Whether the directory exists and can be written.
+     */
+    bool open();
+
+    /**
+     * @brief Key of a solve
+     * @param data Cycle with the instance loaded, holding the starting tour
+     *        if Settings::warmStart is set.
+     * @param settings Algorithm and parameters (the time limit is ignored).
+     * @return 64-bit hash.
+     */
+    static uint64_t key(const Cycle &data, const Algorithms::Settings &settings);
+
+    /**
+     * @brief Fetch a stored result
+     * @param key Key of the solve.
+     * @param data Cycle with the instance loaded, where the tour is stored.
+     * @return Whether the result was found (@p data is unchanged otherwise).
+     */
+    bool lookup(uint64_t key, Cycle &data) const;
+
+    /**
+     * @brief Store a result
+     * @param key Key of the solve.
+     * @param data Tour found.
+     *
+     * The best known tour of the instance is also updated if @p data is
+     * shorter.
+     */
+    void store(uint64_t key, const Cycle &data);
+
+    /**
+     * @brief Fetch the best known tour of an instance
+     * @param data Cycle with the instance loaded, where the tour is stored.
+     * @return Whether there was one (@p data is unchanged otherwise).
+     */
+    bool best(Cycle &data) const;
+
+private:
+    std::string directory;  ///< Directory of the cache
+    long capacity;          ///< Maximum bytes of the stored files
+
+    std::string pathOf(const char *prefix, uint64_t key) const;
+    bool read(const std::string &path, uint64_t key, Cycle &data) const;
+    bool write(const std::string &path, uint64_t key, const Cycle &data) const;
+    void evict() const;
+};
+
+}
+
+#endif /* RESULTCACHE_H */
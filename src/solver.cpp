@@ -0,0 +1,270 @@
+/**
+ * @file solver.cpp
+ * @brief Definition of the solver entry point
+ * @date October 18, 2026
+ */
+
+#include "solver.h"
+#include <cstring>
+#include "cycle.h"
+#include "checkpoint.h"
+
+namespace Algorithms
+{
+
+//------------------------------------------------------------------------------
+// Constructor: default parameters of each algorithm
+
+Settings::Settings(Algorithm algorithm, unsigned int seed)
+{
+    this->algorithm = algorithm;
+    this->seed = seed;
+    count = 2000;
+    size = 30;
+    processes = 5;
+    migrLatency = 1;
+    neighbor = Swap;
+    scheme = Generational;
+    hybridization = Everygen_Everychrom;
+    topology = Ring;
+    crossover = Segment;
+    timeLimit = 0;
+    warmStart = false;
+
+    switch (algorithm) {
+    case GreedyLSExt:
+        count = 5;
+        break;
+
+    case BMB:
+    case Grasp:
+    case ILS:
+    case VNS:
+        count = 50;
+        break;
+
+    case GraspExt:
+        count = 10;
+        break;
+
+    case Memetic:
+        size = 10;
+        break;
+
+    case ParallelSA:
+        count = 20;
+        break;
+
+    case ParallelGenetic:
+        count = 50;
+        size = 10;
+        migrLatency = 2;
+        processes = 4;
+        break;
+
+    default:
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Names of the option values
+
+template <class T>
+struct Name {
+    const char *name;
+    T value;
+};
+
+static const Name<Algorithm> ALGORITHMS[] = {
+    { "greedy", Greedy }, { "rs", RS }, { "ls", LS }, { "vnd", VND },
+    { "sa", SA }, { "greedyls", GreedyLS }, { "greedyls+", GreedyLSExt },
+    { "bmb", BMB }, { "grasp", Grasp }, { "grasp+", GraspExt }, { "ils", ILS },
+    { "vns", VNS }, { "ga", Genetic }, { "ma", Memetic },
+    { "psa", ParallelSA }, { "pga", ParallelGenetic }
+};
+
+static const Name<NeighborGenerator> GENERATORS[] = {
+    { "swap", Swap }, { "invert", Invert }
+};
+
+static const Name<Scheme> SCHEMES[] = {
+    { "gener", Generational }, { "stat", Stationary }
+};
+
+static const Name<Crossover> CROSSOVERS[] = {
+    { "segment", Segment }, { "ox", OX }, { "pmx", PMX },
+    { "eax", EAX }, { "eax-block", EAXBlock }
+};
+
+static const Name<Hybridization> HYBRIDIZATIONS[] = {
+    { "all,2", Everygen_Twochrom }, { "all,all", Everygen_Everychrom },
+    { "10,2", Tengen_Twochrom }, { "10,all", Tengen_Everychrom }
+};
+
+static const Name<Topology> TOPOLOGIES[] = {
+    { "star", Star }, { "ring", Ring }
+};
+
+template <class T, size_t N>
+static bool find(const Name<T> (&names)[N], const char *name, T &value)
+{
+    for (size_t i = 0; i < N; i++) {
+        if (!strcmp(names[i].name, name)) {
+            value = names[i].value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool parse(const char *name, Algorithm &value)
+{
+    return find(ALGORITHMS, name, value);
+}
+
+bool parse(const char *name, NeighborGenerator &value)
+{
+    return find(GENERATORS, name, value);
+}
+
+bool parse(const char *name, Scheme &value)
+{
+    return find(SCHEMES, name, value);
+}
+
+bool parse(const char *name, Crossover &value)
+{
+    return find(CROSSOVERS, name, value);
+}
+
+bool parse(const char *name, Hybridization &value)
+{
+    return find(HYBRIDIZATIONS, name, value);
+}
+
+bool parse(const char *name, Topology &value)
+{
+    return find(TOPOLOGIES, name, value);
+}
+
+//------------------------------------------------------------------------------
+// Run an algorithm on a cycle
+
+bool solve(Cycle &data, const Settings &settings, Checkpoint *checkpoint, long *steps)
+{
+    const bool warm = settings.warmStart;
+    Deadline deadline(settings.timeLimit);
+    Generator generator(settings.seed);
+    Cycle start;
+
+    // Checkpoints keep the starting tour, for the last check after a resume
+
+    if (warm && checkpoint != NULL)
+        checkpoint->setStart(data);
+
+    if (warm)
+        start = data;
+
+    switch (settings.algorithm) {
+    case None:
+        return false;
+
+    case Greedy:
+        greedy(data);
+        break;
+
+    case RS:
+        randomSearch(data, settings.count, settings.seed, deadline);
+        break;
+
+    case LS:
+        if (warm)
+            localSearch(data, deadline);
+        else
+            localSearch(data, settings.seed, deadline);
+
+        break;
+
+    case VND:
+        if (warm)
+            descendantSearch(data, settings.count, generator, deadline);
+        else
+            descendantSearch(data, settings.count, settings.seed, deadline);
+
+        break;
+
+    case SA:
+        if (warm)
+            simulatedAnnealing(data, settings.count, generator, settings.neighbor, true, deadline, checkpoint);
+        else
+            simulatedAnnealing(data, settings.count, settings.seed, settings.neighbor, deadline, checkpoint);
+
+        break;
+
+    case GreedyLS:
+        greedy_bl(data, deadline);
+        break;
+
+    case GreedyLSExt:
+        greedy_blext(data, settings.count, settings.seed, deadline);
+        break;
+
+    case BMB:
+        basicMultibootSearch(data, settings.count, settings.seed, deadline);
+        break;
+
+    case Grasp:
+        grasp(data, settings.count, settings.seed, deadline);
+        break;
+
+    case GraspExt:
+        graspExt(data, settings.count, settings.seed, deadline);
+        break;
+
+    case ILS:
+        if (warm)
+            iteratedLocalSearch(data, settings.count, generator, deadline);
+        else
+            iteratedLocalSearch(data, settings.count, settings.seed, deadline);
+
+        break;
+
+    case VNS:
+        if (warm)
+            variableSearch(data, settings.count, generator, deadline);
+        else
+            variableSearch(data, settings.count, settings.seed, deadline);
+
+        break;
+
+    case Genetic:
+        genetic(data, settings.size, settings.count, settings.scheme, settings.crossover, settings.seed, warm, deadline, checkpoint);
+        break;
+
+    case Memetic:
+        memetic(data, settings.size, settings.count, settings.hybridization, settings.crossover, settings.seed, warm, deadline, checkpoint);
+        break;
+
+    case ParallelSA:
+        parallelAnnealing(data, settings.processes, settings.count, settings.migrLatency, settings.seed, warm, deadline, checkpoint);
+        break;
+
+    case ParallelGenetic:
+        parallelGenetic(data, settings.processes, settings.size, settings.count, settings.migrLatency, settings.topology, settings.crossover, settings.seed, warm, deadline, checkpoint);
+    }
+
+    // Annealing and constructive searches may end on a worse tour than the
+    // given one, which is never lost
+
+    if (warm && start.getCost() < data.getCost())
+        data.setPath(start);
+
+    if (steps != NULL)
+        *steps = deadline.getSteps();
+
+    return true;
+}
+
+}
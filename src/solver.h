@@ -0,0 +1,90 @@
+/**
+ * @file solver.h
+ * @brief Declaration of the solver entry point
+ * @date October 18, 2026
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "algorithms.h"
+
+namespace Algorithms
+{
+
+/// Algorithms that solve() can run
+enum Algorithm { None, Greedy, RS, LS, VND, SA,
+                 GreedyLS, GreedyLSExt, BMB, Grasp, GraspExt, ILS, VNS,
+                 Genetic, Memetic, ParallelSA, ParallelGenetic
+               };
+
+/**
+ * @brief Configuration of a solve
+ *
+ * Every parameter of the algorithms lives here, so that several solves with
+ * different settings can run at the same time.
+ */
+struct Settings {
+    Algorithm algorithm;        ///< Algorithm to run
+    int count;                  ///< Repetitions or generations
+    int size;                   ///< Width of the population
+    int processes;              ///< Number of islands or replicas
+    int migrLatency;            ///< Generations between migrations
+    unsigned int seed;          ///< Seed of the random streams
+    NeighborGenerator neighbor; ///< Neighbor generator of annealing
+    Scheme scheme;              ///< Evolutionary scheme of the GA
+    Hybridization hybridization;    ///< Hybridization of the memetic algorithm
+    Topology topology;          ///< Migration topology of the parallel GA
+    Crossover crossover;        ///< Crossover operator
+    long timeLimit;             ///< Wall time budget in milliseconds (0: none)
+    bool warmStart;             ///< Start from the tour in the cycle
+
+    /**
+     * @brief Constructor
+     * @param algorithm Algorithm to run.
+     * @param seed Seed of the random streams.
+     *
+     * The rest of parameters take the default values of the algorithm.
+     */
+    explicit Settings(Algorithm algorithm = None, unsigned int seed = 0);
+};
+
+/**
+ * @brief Parse the name of an option value
+ * @param name Name used on the command line (e.g. "ga", "eax", "10,2").
+ * @param value Destination, unchanged if the name is unknown.
+ * @return Whether the name was recognized.
+ */
+bool parse(const char *name, Algorithm &value);
+bool parse(const char *name, NeighborGenerator &value);
+bool parse(const char *name, Scheme &value);
+bool parse(const char *name, Crossover &value);
+bool parse(const char *name, Hybridization &value);
+bool parse(const char *name, Topology &value);
+
+/**
+ * @brief Run an algorithm on a cycle
+ * @param data Cycle with the instance loaded, where the result is stored.
+ * @param settings Algorithm and parameters.
+ * @param checkpoint Checkpoint to save to and to resume from (NULL for none),
+ *        for the algorithms that Checkpoint::supports().
+ * @param steps Destination of the steps of the main loop of the search, as
+ *        counted by its Deadline (NULL for none). A step ranges from a few
+ *        moves to a generation, depending on the algorithm.
+ *
+ * It keeps no state between calls, and it may be called from several threads
+ * at once on different cycles. If the time limit passes or Deadline::interrupt()
+ * is called, the search stops early and @p data holds the best tour found.
+ *
+ * With Settings::warmStart, the tour in @p data is improved instead of built
+ * from scratch: single-solution searches start from it, population searches
+ * seed part of their population with it, and the rest keep it as the tour to
+ * beat. The result is never worse than the given tour.
+ *
+ * @return Whether an algorithm was run (false for None).
+ */
+bool solve(Cycle &data, const Settings &settings, Checkpoint *checkpoint = NULL, long *steps = NULL);
+
+}
+
+#endif /* SOLVER_H */
@@ -0,0 +1,267 @@
+/**
+ * @file synthetic.cpp
+ * @brief Definition of the Synthetic class
+ * @date October 19, 2026
+ */
+
+#include "synthetic.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+namespace Tsp
+{
+
+/// Names of the distributions
+static const struct {
+    const char *name;
+    Synthetic::Distribution value;
+} distributions[] = {
+    { "uniform", Synthetic::Uniform },
+    { "clustered", Synthetic::Clustered },
+    { "grid", Synthetic::Grid },
+    { "road", Synthetic::Road }
+};
+
+//------------------------------------------------------------------------------
+// Constructor
+
+Synthetic::Synthetic(Distribution distribution, long count, uint64_t seed, double side) : generator(seed)
+{
+    this->distribution = distribution;
+    this->count = count > 0 ? count : 0;
+    this->side = side;
+    this->seed = seed;
+    done = 0;
+    deviation = 0;
+    columns = 1;
+
+    switch (distribution) {
+    case Clustered:
+        centers.resize(std::max(1L, (this->count + SYNTHETIC_CLUSTER - 1) / SYNTHETIC_CLUSTER));
+
+        for (size_t i = 0; i < centers.size(); i++) {
+            centers[i].x = (float)(uniform() * side);
+            centers[i].y = (float)(uniform() * side);
+        }
+
+        deviation = side / sqrt((double)std::max(1L, this->count));
+        break;
+
+    case Grid:
+        columns = std::max(1L, (long)ceil(sqrt((double)this->count)));
+        break;
+
+    case Road:
+        buildRoads();
+        break;
+
+    default:
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Parse the name of a distribution
+
+bool Synthetic::parse(const char *name, Distribution &value)
+{
+    for (size_t i = 0; i < sizeof(distributions) / sizeof(distributions[0]); i++) {
+        if (!strcmp(distributions[i].name, name)) {
+            value = distributions[i].value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Draw the next point
+
+bool Synthetic::next(Point &point)
+{
+    double x, y;
+
+    if (done >= count)
+        return false;
+
+    switch (distribution) {
+    case Clustered: {
+        const Point &center = centers[(size_t)(uniform() * centers.size())];
+        x = center.x + normal() * deviation;
+        y = center.y + normal() * deviation;
+        break;
+    }
+
+    case Grid: {
+        // Whole coordinates, so that every edge of the lattice has the same length
+        const double spacing = gridSpacing();
+        x = (done % columns) * spacing + floor(spacing / 2);
+        y = (done / columns) * spacing + floor(spacing / 2);
+        break;
+    }
+
+    case Road:
+        if (uniform() < 0.1) {
+            const Point &town = centers[(size_t)(uniform() * centers.size())];
+            x = town.x + normal() * deviation;
+            y = town.y + normal() * deviation;
+        } else {
+            // Roads are picked in proportion to their length
+            const size_t road = std::upper_bound(lengths.begin(), lengths.end(), uniform() * lengths.back()) - lengths.begin();
+            const Point &from = centers[roads[2 * std::min(road, lengths.size() - 1)]];
+            const Point &to = centers[roads[2 * std::min(road, lengths.size() - 1) + 1]];
+            const double t = uniform();
+
+            x = from.x + (to.x - from.x) * t + normal() * deviation / 8;
+            y = from.y + (to.y - from.y) * t + normal() * deviation / 8;
+        }
+
+        break;
+
+    default:
+        x = uniform() * side;
+        y = uniform() * side;
+    }
+
+    point.x = (float)x;
+    point.y = (float)y;
+    done++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Length of the optimal tour, if known
+
+double Synthetic::optimum() const
+{
+    // A lattice with an even side has a tour of unit steps only
+
+    if (distribution != Grid || columns * columns != count || columns % 2 != 0)
+        return 0;
+
+    return count * gridSpacing();
+}
+
+//------------------------------------------------------------------------------
+// Draw every point left
+
+std::vector<Point> Synthetic::points()
+{
+    std::vector<Point> result;
+    Point point;
+
+    result.reserve(count - done);
+
+    while (next(point))
+        result.push_back(point);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Write every point left as a TSPLIB file
+
+bool Synthetic::write(const char *path, const char *name)
+{
+    const bool standard = !strcmp(path, "-");
+    FILE *file = standard ? stdout : fopen(path, "w");
+    const long first = done;
+    Point point;
+    bool success;
+
+    if (file == NULL) {
+        std::cerr << "Could not open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    // Coordinates are written with every digit of a float, so they read back the same
+
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
+    fprintf(file, "NAME : %s\n", name);
+    fprintf(file, "COMMENT : %s points, seed %llu\n", distributions[distribution].name, (unsigned long long)seed);
+    fprintf(file, "TYPE : TSP\n");
+    fprintf(file, "DIMENSION : %ld\n", count - first);
+    fprintf(file, "EDGE_WEIGHT_TYPE : EUC_2D\n");
+    fprintf(file, "NODE_COORD_SECTION\n");
+
+    while (next(point))
+        fprintf(file, "%ld %.9g %.9g\n", done - first, point.x, point.y);
+
+    fprintf(file, "EOF\n");
+    success = fflush(file) == 0 && !ferror(file);
+
+    if (!standard)
+        success = fclose(file) == 0 && success;
+
+    if (!success)
+        std::cerr << "Write error on " << path << std::endl;
+
+    return success;
+}
+
+//------------------------------------------------------------------------------
+// Distance between neighbors of the grid
+
+double Synthetic::gridSpacing() const
+{
+    return std::max(1.0, floor(side / columns));
+}
+
+//------------------------------------------------------------------------------
+// Real number in [0, 1[
+
+double Synthetic::uniform()
+{
+    return (generator() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//------------------------------------------------------------------------------
+// Standard normal number (Box-Muller)
+
+double Synthetic::normal()
+{
+    const double radius = sqrt(-2.0 * log(1.0 - uniform()));
+    return radius * cos(2.0 * M_PI * uniform());
+}
+
+//------------------------------------------------------------------------------
+// Place the towns and join each one to its nearest towns
+
+void Synthetic::buildRoads()
+{
+    const size_t towns = std::max(SYNTHETIC_ROADS + 1L, count / SYNTHETIC_TOWN);
+    std::vector<std::pair<double, int> > nearest(towns);
+    double total = 0;
+
+    centers.resize(towns);
+
+    for (size_t i = 0; i < towns; i++) {
+        centers[i].x = (float)(uniform() * side);
+        centers[i].y = (float)(uniform() * side);
+    }
+
+    // A town spreads over a fraction of the space between towns
+    deviation = side / sqrt((double)towns) / 8;
+
+    for (size_t i = 0; i < towns; i++) {
+        for (size_t j = 0; j < towns; j++) {
+            const double dx = centers[i].x - centers[j].x, dy = centers[i].y - centers[j].y;
+            nearest[j] = std::make_pair(i == j ? HUGE_VAL : dx * dx + dy * dy, (int)j);
+        }
+
+        std::partial_sort(nearest.begin(), nearest.begin() + SYNTHETIC_ROADS, nearest.end());
+
+        for (int k = 0; k < SYNTHETIC_ROADS; k++) {
+            roads.push_back((int)i);
+            roads.push_back(nearest[k].second);
+            total += sqrt(nearest[k].first);
+            lengths.push_back(total);
+        }
+    }
+}
+
+}
@@ -0,0 +1,110 @@
+/**
+ * @file synthetic.h
+ * @brief Declaration of the Synthetic class
+ * @date October 19, 2026
+ */
+
+#ifndef SYNTHETIC_H
+#define SYNTHETIC_H
+
+#include <vector>
+#include "tsp.h"
+#include "generator.h"
+
+#define SYNTHETIC_SIDE 1000000.0    ///< Default side of the square of the points
+#define SYNTHETIC_CLUSTER 100       ///< Mean points of a cluster
+#define SYNTHETIC_TOWN 1000         ///< Mean points of a town of the road network
+#define SYNTHETIC_ROADS 2           ///< Roads from each town to its nearest ones
+
+namespace Tsp
+{
+
+/**
+ * @brief Synthetic Class
+ *
+ * Seeded generator of point sets, drawn one by one so that instances of
+ * millions of cities can be written without holding them in memory. Only
+ * the clusters or the road network are kept, about one in a hundred points.
+ *
+ * - Uniform: points uniformly distributed in the square.
+ * - Clustered: normal clouds around uniform centers, one per hundred points,
+ *   with a deviation of side / sqrt(count), as in the DIMACS TSP challenge.
+ * - Grid: square lattice, row by row, with whole coordinates. The seed is
+ *   not used, and the optimal tour is known (see optimum()).
+ * - Road: towns joined to their nearest towns by straight roads. A tenth of
+ *   the points gather around the towns, and the rest lie along the roads.
+ */
+class Synthetic
+{
+public:
+
+    /// Point distributions
+    enum Distribution { Uniform, Clustered, Grid, Road };
+
+    /**
+     * @brief Constructor
+     * @param distribution Shape of the point set.
+     * @param count Number of points.
+     * @param seed Seed of the sequence.
+     * @param side Side of the square that holds the points.
+     */
+    Synthetic(Distribution distribution, long count, uint64_t seed, double side = SYNTHETIC_SIDE);
+
+    /**
+     * @brief Parse the name of a distribution
+     * @param name "uniform", "clustered", "grid" or "road".
+     * @param value Destination, unchanged if the name is unknown.
+     * @return Whether the name was recognized.
+     */
+    static bool parse(const char *name, Distribution &value);
+
+    /**
+     * @brief Draw the next point
+     * @param point Destination.
+     * @return Whether there was a point left.
+     */
+    bool next(Point &point);
+
+    /**
+     * @brief Length of the optimal tour
+     * @return Length under the EUC_2D metric, for a grid whose count is the
+     *         square of an even number, or 0 if it is not known.
+     */
+    double optimum() const;
+
+    /**
+     * @brief Draw every point left
+     * @return Points, in the order of next().
+     */
+    std::vector<Point> points();
+
+    /**
+     * @brief Write every point left as a TSPLIB file
+     * @param path File path ("-" for the standard output).
+     * @param name Value of the NAME keyword.
+     * @return Whether it was written correctly.
+     */
+    bool write(const char *path, const char *name);
+
+private:
+    Distribution distribution;
+    long count;                 ///< Number of points
+    long done;                  ///< Points drawn so far
+    double side;
+    uint64_t seed;
+    Xoshiro256 generator;
+    std::vector<Point> centers; ///< Centers of the clusters, or towns
+    std::vector<int> roads;     ///< Pairs of towns joined by a road
+    std::vector<double> lengths;    ///< Cumulative length of the roads
+    double deviation;           ///< Spread around a center or a road
+    long columns;               ///< Points per row of the grid
+
+    double uniform();
+    double normal();
+    double gridSpacing() const;
+    void buildRoads();
+};
+
+}
+
+#endif /* SYNTHETIC_H */
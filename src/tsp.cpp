@@ -0,0 +1,246 @@
+/**
+ * @file tsp.cpp
+ * @brief Definition of the public interface of the tsp_core library
+ * @date October 18, 2026
+ */
+
+#include "tsp.h"
+
+namespace Tsp
+{
+
+//------------------------------------------------------------------------------
+// Constructor of an empty problem
+
+Problem::Problem()
+{
+}
+
+//------------------------------------------------------------------------------
+// Load nodes from a TSP file
+
+bool Problem::load(const char *path, Instance::Layout layout, Instance::Order order)
+{
+    return sample.loadTsp(path, layout, order);
+}
+
+//------------------------------------------------------------------------------
+// Load nodes from memory
+
+bool Problem::load(const std::vector<Point> &points, Instance::Layout layout, Instance::Order order)
+{
+    return sample.loadVertices(points.data(), (int)points.size(), layout, order);
+}
+
+//------------------------------------------------------------------------------
+// Map a raw distance matrix
+
+bool Problem::loadMatrix(const char *path, Instance::Weight weight)
+{
+    return sample.loadMatrix(path, weight);
+}
+
+//------------------------------------------------------------------------------
+// Run an algorithm
+
+Result Problem::solve(const Algorithms::Settings &settings, ResultCache *results) const
+{
+    Cycle data(sample);
+    return run(data, settings, results);
+}
+
+//------------------------------------------------------------------------------
+// Improve a tour
+
+Result Problem::solve(const Algorithms::Settings &settings, const std::vector<int> &tour, ResultCache *results) const
+{
+    Algorithms::Settings warm = settings;
+    Cycle data(sample);
+    Result result;
+
+    if (!data.setTour(tour.data(), (int)tour.size())) {
+        result.solved = false;
+        result.cached = false;
+        result.cost = 0.0;
+        result.steps = 0;
+        return result;
+    }
+
+    warm.warmStart = true;
+    return run(data, warm, results);
+}
+
+//------------------------------------------------------------------------------
+// Solve from a cycle, through the cache
+
+Result Problem::run(Cycle &data, const Algorithms::Settings &settings, ResultCache *results) const
+{
+    const bool active = results != NULL && getSize() > 0 && settings.algorithm != Algorithms::None;
+    const uint64_t key = active ? ResultCache::key(data, settings) : 0;
+    Result result;
+
+    result.steps = 0;
+    result.cached = active && results->lookup(key, data);
+
+    if (result.cached)
+        result.solved = true;
+    else {
+        const unsigned long interruptions = Algorithms::Deadline::interruptions();
+        result.solved = getSize() > 0 && Algorithms::solve(data, settings, NULL, &result.steps);
+
+        if (active && result.solved && settings.timeLimit == 0 && Algorithms::Deadline::interruptions() == interruptions)
+            results->store(key, data);
+    }
+
+    result.cost = data.getCost();
+    store(data, result.tour);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Add a city
+
+int Problem::insert(const Point &point, std::vector<int> &tour)
+{
+    if (!sample.setTour(tour.data(), (int)tour.size()) || !sample.insertVertex(point))
+        return -1;
+
+    const int node = getSize() - 1;
+
+    touched.push_back(node);
+    store(sample, tour);
+    return sample.getInstance()->idOf(node);
+}
+
+//------------------------------------------------------------------------------
+// Remove a city
+
+bool Problem::remove(int city, std::vector<int> &tour)
+{
+    const int position = locate(city, tour);
+
+    if (position < 0 || getSize() < 2)
+        return false;
+
+    const int node = sample.edgeAt(position);
+    const int last = getSize() - 1;
+    const int previous = sample.edgeAt((position + getSize() - 1) % getSize());
+    const int next = sample.edgeAt((position + 1) % getSize());
+
+    if (!sample.removeVertex(node))
+        return false;
+
+    // The last node took the index of the removed one
+
+    touched.push_back(previous);
+    touched.push_back(next);
+
+    for (size_t i = 0; i < touched.size(); i++) {
+        if (touched[i] == node)
+            touched[i] = -1;
+        else if (touched[i] == last)
+            touched[i] = node;
+    }
+
+    store(sample, tour);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Move a city
+
+bool Problem::move(int city, const Point &point, std::vector<int> &tour)
+{
+    const int position = locate(city, tour);
+
+    if (position < 0)
+        return false;
+
+    const int node = sample.edgeAt(position);
+    const int previous = sample.edgeAt((position + getSize() - 1) % getSize());
+    const int next = sample.edgeAt((position + 1) % getSize());
+
+    if (!sample.moveVertex(node, point))
+        return false;
+
+    touched.push_back(previous);
+    touched.push_back(next);
+    touched.push_back(node);
+    store(sample, tour);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Improve a tour around the edits
+
+Result Problem::repair(const std::vector<int> &tour, long timeLimit)
+{
+    Algorithms::Deadline deadline(timeLimit);
+    Cycle data(sample);
+    Result result;
+
+    result.cached = false;
+    result.steps = 0;
+    result.solved = data.setTour(tour.data(), (int)tour.size());
+
+    if (!result.solved) {
+        result.cost = 0.0;
+        return result;
+    }
+
+    result.steps = Algorithms::localRepair(data, touched.data(), (int)touched.size(), deadline);
+    touched.clear();
+
+    result.cost = data.getCost();
+    store(data, result.tour);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Load a tour into the sample and find a city
+
+int Problem::locate(int city, std::vector<int> &tour)
+{
+    if (city < 0 || city >= getSize() || !sample.setTour(tour.data(), (int)tour.size()))
+        return -1;
+
+    for (int i = 0; i < getSize(); i++) {
+        if (sample.idAt(i) == city)
+            return i;
+    }
+
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+// Numbers of the nodes of a path
+
+void Problem::store(const Cycle &data, std::vector<int> &tour) const
+{
+    tour.resize(data.getSize());
+
+    for (int i = 0; i < data.getSize(); i++)
+        tour[i] = data.idAt(i);
+}
+
+//------------------------------------------------------------------------------
+// Cost of a tour
+
+float Problem::cost(const std::vector<int> &tour) const
+{
+    const std::shared_ptr<const Instance> &instance = sample.getInstance();
+    std::vector<int> indexes(tour.size());
+    float value = 0.0;
+
+    // Translate node numbers into internal indexes
+
+    for (int i = 0; i < getSize(); i++)
+        indexes[instance->idOf(i)] = i;
+
+    for (size_t i = 0; i < tour.size(); i++)
+        value += instance->distance(indexes[tour[i]], indexes[tour[(i + 1) % tour.size()]]);
+
+    return value;
+}
+
+}
@@ -0,0 +1,181 @@
+/**
+ * @file tsp.h
+ * @brief Public interface of the tsp_core library
+ * @date October 18, 2026
+ */
+
+#ifndef TSP_H
+#define TSP_H
+
+#include <vector>
+#include "cycle.h"
+#include "solver.h"
+#include "allocator.h"
+#include "resultcache.h"
+
+namespace Tsp
+{
+
+typedef Instance::Vertex Point;
+
+/// Outcome of a solve
+struct Result {
+    bool solved;            ///< Whether an algorithm was run
+    bool cached;            ///< Whether it was taken from a ResultCache
+    float cost;             ///< Length of the tour
+    long steps;             ///< Steps of the search (see Algorithms::solve()),
+                            ///< or improving moves of repair()
+    std::vector<int> tour;  ///< Zero-based node numbers, as given to the problem
+};
+
+/**
+ * @brief Problem Class
+ *
+ * Instance of the problem kept in memory, with its distance matrix and the
+ * rest of derived data, so that it can be solved many times without loading
+ * it again. A problem can be solved from several threads at once.
+ *
+ * Cities can be added, removed or moved between solves, which updates the
+ * derived data in place and the given tour by cheapest insertion. repair()
+ * then improves the tour around the cities that changed only. Edits must not
+ * run at the same time as a solve.
+ */
+class Problem
+{
+public:
+
+    /// Constructor of an empty problem
+    Problem();
+
+    /**
+     * @brief Load nodes from a TSP file
+     * @param path File path.
+     * @param layout Storage layout of the distance matrix.
+     * @param order Internal numbering of the nodes.
+     * @return Whether it was read correctly.
+     */
+    bool load(const char *path, Instance::Layout layout = Instance::Packed, Instance::Order order = Instance::Original);
+
+    /**
+     * @brief Load nodes from memory
+     * @param points Coordinates of the nodes.
+     * @param layout Storage layout of the distance matrix.
+     * @param order Internal numbering of the nodes.
+     * @return Whether the nodes were accepted.
+     */
+    bool load(const std::vector<Point> &points, Instance::Layout layout = Instance::Packed, Instance::Order order = Instance::Original);
+
+    /**
+     * @brief Map a raw distance matrix
+     * @param path Path of a file with the full matrix, row by row.
+     * @param weight Type of the cells.
+     * @return Whether the file was mapped.
+     */
+    bool loadMatrix(const char *path, Instance::Weight weight);
+
+    /**
+     * @brief Get size
+     * @return Number of nodes (0 if nothing is loaded).
+     */
+    inline int getSize() const
+    {
+        return sample.getSize();
+    }
+
+    /**
+     * @brief Run an algorithm
+     * @param settings Algorithm and parameters.
+     * @param results Cache of results to look up first and to update (NULL
+     *        for none). Searches cut short by a time limit are not stored.
+     * @return Best tour found.
+     */
+    Result solve(const Algorithms::Settings &settings, ResultCache *results = NULL) const;
+
+    /**
+     * @brief Improve a tour
+     * @param settings Algorithm and parameters.
+     * @param tour Zero-based node numbers, as given to the problem.
+     * @param results Cache of results (NULL for none).
+     *
+     * The algorithm starts from @p tour (see Settings::warmStart), which is
+     * useful to re-optimize after a small change of the instance.
+     *
+     * @return Best tour found, not solved if @p tour is not a permutation of
+     *         [0, getSize()[.
+     */
+    Result solve(const Algorithms::Settings &settings, const std::vector<int> &tour, ResultCache *results = NULL) const;
+
+    /**
+     * @brief Add a city
+     * @param point Coordinates of the city.
+     * @param tour Tour over the current cities (zero-based numbers), where the
+     *        city is inserted at the cheapest position.
+     * @return Number of the new city (the former size), or -1 on failure.
+     */
+    int insert(const Point &point, std::vector<int> &tour);
+
+    /**
+     * @brief Remove a city
+     * @param city Number of the city.
+     * @param tour Tour over the current cities, where the neighbors of the
+     *        city are joined.
+     *
+     * Cities above @p city are renumbered one less, in the problem and in
+     * @p tour, as if it was erased from the list of points.
+     *
+     * @return Whether the city was removed.
+     */
+    bool remove(int city, std::vector<int> &tour);
+
+    /**
+     * @brief Move a city
+     * @param city Number of the city.
+     * @param point New coordinates.
+     * @param tour Tour over the current cities, where the city is inserted
+     *        again at the cheapest position.
+     * @return Whether the city was moved.
+     */
+    bool move(int city, const Point &point, std::vector<int> &tour);
+
+    /**
+     * @brief Improve a tour around the edits
+     * @param tour Tour over the current cities.
+     * @param timeLimit Budget in milliseconds (0 for none).
+     *
+     * A 2-opt search over the candidate lists starts from the cities edited
+     * since the last repair, and their neighbors in the tour, and it goes on
+     * only as far as it finds improvements.
+     *
+     * @return Improved tour, not solved if @p tour is not a permutation.
+     */
+    Result repair(const std::vector<int> &tour, long timeLimit = 0);
+
+    /**
+     * @brief Cost of a tour
+     * @param tour Zero-based node numbers, as given to the problem.
+     * @pre @p tour must be a permutation of [0, getSize()[.
+     * @return Length of the tour.
+     */
+    float cost(const std::vector<int> &tour) const;
+
+    /**
+     * @brief Underlying cycle
+     * @return Cycle over the instance, in canonical order.
+     */
+    inline const Cycle & getCycle() const
+    {
+        return sample;
+    }
+
+private:
+    Cycle sample;   ///< Shares the instance with every solve
+    std::vector<int> touched;   ///< Nodes next to the edits since repair()
+
+    Result run(Cycle &data, const Algorithms::Settings &settings, ResultCache *results) const;
+    int locate(int city, std::vector<int> &tour);
+    void store(const Cycle &data, std::vector<int> &tour) const;
+};
+
+}
+
+#endif /* TSP_H */
@@ -8,29 +8,34 @@
 namespace Algorithms
 {
 
-void variableSearch(Cycle &data, int count, unsigned int seed)
+void variableSearch(Cycle &data, int count, unsigned int seed, Deadline &deadline)
+{
+    Generator generator(seed);
+
+    data.shufflePath(generator);
+    variableSearch(data, count, generator, deadline);
+}
+
+void variableSearch(Cycle &data, int count, Generator &generator, Deadline &deadline)
 {
     Cycle &bestCycle = data;
     Cycle curCycle = data;
-    std::mt19937 generator(seed);
     int k = 1, bl = 0;
 
-    bestCycle.shufflePath(generator);
-
     do {
         if (k > KMAX)
             k = 1;
 
         curCycle.setPath(bestCycle);
         curCycle.shuffleSubpath(data.getSize() / (9 - k), generator);
-        localSearch(curCycle);
+        localSearch(curCycle, deadline);
 
         if (curCycle.getCost() < bestCycle.getCost()) {
             bestCycle.setPath(curCycle);
             k = 1;
         } else
             k++;
-    } while (++bl < count);
+    } while (++bl < count && !deadline.expired());
 }
 
 }
@@ -0,0 +1,46 @@
+/**
+ * @file check.h
+ * @brief Checks shared by the test programs
+ * @date October 19, 2026
+ *
+ * A test runs all its checks, reports each failure on the standard error and
+ * returns testStatus() from main().
+ */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#ifndef TSP_DATA_DIR
+#define TSP_DATA_DIR "data"
+#endif
+
+/// Number of failed checks
+static int failures = 0;
+
+/**
+ * @brief Report a failed check
+ * @param passed Result of the check.
+ * @param what Description of the check.
+ */
+static inline void check(bool passed, const std::string &what)
+{
+    if (!passed) {
+        std::cerr << "Failed: " << what << std::endl;
+        failures++;
+    }
+}
+
+/**
+ * @brief Result of the test
+ * @return EXIT_SUCCESS if every check passed, EXIT_FAILURE otherwise.
+ */
+static inline int testStatus()
+{
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* CHECK_H */
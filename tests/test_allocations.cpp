@@ -0,0 +1,105 @@
+/**
+ * @file test_allocations.cpp
+ * @brief Check that the generations of a population allocate no memory
+ * @date October 19, 2026
+ *
+ * Counts the calls to operator new and to the Allocator while a population
+ * evolves, with every crossover and both replacement schemes. The first
+ * generations are not counted, as some buffers are sized on first use.
+ */
+
+#include <string>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "population.h"
+#include "allocator.h"
+#include "check.h"
+
+#define TEST_SIZE 50            ///< Chromosomes of the population
+#define TEST_WARMUP 20          ///< Generations before counting
+#define TEST_GENERATIONS 500    ///< Generations counted per scheme
+
+using std::string;
+
+/// Calls to operator new since the start
+static std::atomic<long> heapCalls(0);
+
+void * operator new(size_t bytes)
+{
+    void *ptr = malloc(bytes ? bytes : 1);
+
+    heapCalls++;
+
+    if (ptr == NULL)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void * operator new[](size_t bytes)
+{
+    return operator new(bytes);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+/// Crossovers under test
+static const struct {
+    const char *name;
+    Algorithms::Crossover crossover;
+} crossovers[] = {
+    { "segment", Algorithms::Segment },
+    { "ox", Algorithms::OX },
+    { "pmx", Algorithms::PMX },
+    { "eax", Algorithms::EAX }
+};
+
+/// Replacement schemes under test
+static const struct {
+    const char *name;
+    Algorithms::Scheme scheme;
+} schemes[] = {
+    { "generational", Algorithms::Generational },
+    { "stationary", Algorithms::Stationary }
+};
+
+int main()
+{
+    Cycle data;
+
+    if (!data.loadTsp(TSP_DATA_DIR "/kroA100.tsp"))
+        return EXIT_FAILURE;
+
+    for (size_t i = 0; i < sizeof(crossovers) / sizeof(crossovers[0]); i++) {
+        for (size_t j = 0; j < sizeof(schemes) / sizeof(schemes[0]); j++) {
+            Algorithms::Generator generator(1);
+            Population population(TEST_SIZE, data, generator, crossovers[i].crossover);
+
+            for (int k = 0; k < TEST_WARMUP; k++)
+                population.evolve(schemes[j].scheme);
+
+            const long heap = heapCalls;
+            const Allocator::Stats before = Allocator::stats();
+
+            for (int k = 0; k < TEST_GENERATIONS; k++)
+                population.evolve(schemes[j].scheme);
+
+            const Allocator::Stats after = Allocator::stats();
+            const long news = heapCalls - heap;
+            const long blocks = (long)(after.allocations - before.allocations);
+
+            check(news == 0 && blocks == 0, string(crossovers[i].name) + ", " + schemes[j].name + ": " + std::to_string(news) + " calls to operator new and " + std::to_string(blocks) + " blocks allocated");
+        }
+    }
+
+    return testStatus();
+}
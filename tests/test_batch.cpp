@@ -0,0 +1,168 @@
+/**
+ * @file test_batch.cpp
+ * @brief Check the parsing of batch manifests and their summaries
+ * @date October 19, 2026
+ *
+ * The same jobs are given as fields and as CSV, and must give the same
+ * groups, costs and tours. Summary lines must hold the mean, the standard
+ * deviation and the best cost of the job lines of their group.
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include "batch.h"
+#include "check.h"
+
+#define TEST_INSTANCE TSP_DATA_DIR "/berlin52.tsp"
+#define TEST_WORKERS 2
+
+using std::string;
+using std::vector;
+
+/// Lines of the output of a batch
+struct Output {
+    std::map<string, vector<string> > jobs;     ///< Cells of the job lines, by id
+    std::map<string, vector<string> > summaries;    ///< Cells of the summaries, by settings
+};
+
+/**
+ * @brief Split a CSV line
+ * @param line Cells separated by commas.
+ * @return Cells, including an empty last one.
+ */
+static vector<string> split(const string &line)
+{
+    vector<string> cells;
+    size_t start = 0, comma;
+
+    while ((comma = line.find(',', start)) != string::npos) {
+        cells.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+
+    cells.push_back(line.substr(start));
+    return cells;
+}
+
+/**
+ * @brief Load and run a manifest
+ * @param text Contents of the manifest.
+ * @param output Destination of the parsed lines.
+ * @return Whether the manifest was accepted and all its jobs were run.
+ */
+static bool runManifest(const string &text, Output &output)
+{
+    char path[] = "/tmp/tsp_manifestXXXXXX";
+    const int fd = mkstemp(path);
+    std::ostringstream stream;
+    Tsp::Batch batch(TEST_WORKERS);
+    string line;
+
+    if (fd < 0)
+        return false;
+
+    const bool written = write(fd, text.data(), text.size()) == (ssize_t)text.size();
+    close(fd);
+
+    const bool success = written && batch.load(path) && batch.run(stream);
+    unlink(path);
+
+    std::istringstream lines(stream.str());
+
+    while (std::getline(lines, line)) {
+        const vector<string> cells = split(line);
+
+        if (cells.size() == 11 && cells[0] == "job")
+            output.jobs[cells[1]] = cells;
+        else if (cells.size() == 8 && cells[0] == "summary")
+            output.summaries[cells[2]] = cells;
+    }
+
+    return success;
+}
+
+int main()
+{
+    const string tsp = TEST_INSTANCE;
+    Output fields, csv, rejected;
+
+    // Comments, blank lines and spaces around the cells are skipped
+
+    check(runManifest("# Local searches\n"
+                      "\n"
+                      "id=1 tsp=" + tsp + " algorithm=ls seed=1\n"
+                      "id=2 tsp=" + tsp + " algorithm=ls seed=2\n"
+                      "id=3 tsp=" + tsp + " algorithm=ls seed=3\n"
+                      "   # Descent\n"
+                      "id=4 tsp=" + tsp + " algorithm=vnd count=5 seed=1\n"
+                      "id=5 tsp=" + tsp + " algorithm=vnd count=5 seed=2\r\n", fields), "manifest of fields");
+
+    check(runManifest("id,tsp,algorithm,count,seed\n"
+                      "1," + tsp + ",ls,,1\n"
+                      "2, " + tsp + " ,ls,,2\n"
+                      "# Comment\n"
+                      "3," + tsp + ",ls,,3\n"
+                      "4," + tsp + ",vnd,5,1\n"
+                      "5," + tsp + ",vnd,5,2\n", csv), "CSV manifest");
+
+    check(fields.jobs.size() == 5 && csv.jobs.size() == 5, "five jobs of each manifest");
+    check(fields.summaries.size() == 2 && csv.summaries.size() == 2, "two groups of each manifest");
+    check(fields.summaries.count("algorithm=ls") && fields.summaries.count("algorithm=vnd count=5"), "groups named after their settings");
+
+    // Both manifests describe the same jobs
+
+    for (std::map<string, vector<string> >::const_iterator it = fields.jobs.begin(); it != fields.jobs.end(); ++it) {
+        const vector<string> &job = it->second;
+        const vector<string> &other = csv.jobs[it->first];
+
+        check(other.size() == job.size() && other[3] == job[3] && other[4] == job[4] && other[5] == job[5], "job " + it->first + " is the same in both manifests");
+    }
+
+    // Summaries over the job lines of each group
+
+    for (std::map<string, vector<string> >::const_iterator it = fields.summaries.begin(); it != fields.summaries.end(); ++it) {
+        const vector<string> &summary = it->second;
+        vector<double> costs;
+        double mean = 0, squares = 0, best = HUGE_VAL;
+
+        for (std::map<string, vector<string> >::const_iterator job = fields.jobs.begin(); job != fields.jobs.end(); ++job) {
+            if (job->second[3] == it->first) {
+                const double cost = atof(job->second[5].c_str());
+
+                costs.push_back(cost);
+                mean += cost;
+
+                best = std::min(best, cost);
+            }
+        }
+
+        mean /= costs.size();
+
+        for (size_t i = 0; i < costs.size(); i++)
+            squares += (costs[i] - mean) * (costs[i] - mean);
+
+        const double deviation = costs.size() > 1 ? sqrt(squares / (costs.size() - 1)) : 0.0;
+
+        check(atoi(summary[3].c_str()) == (int)costs.size(), "runs of " + it->first);
+        check(fabs(atof(summary[4].c_str()) - mean) <= 1e-5 * mean, "mean of " + it->first);
+        check(fabs(atof(summary[5].c_str()) - deviation) <= 1e-5 * mean, "deviation of " + it->first);
+        check(atof(summary[6].c_str()) == best, "best cost of " + it->first);
+        check(fields.jobs.count(summary[7]) && atof(fields.jobs[summary[7]][5].c_str()) == best, "id of the best run of " + it->first);
+    }
+
+    // Invalid manifests
+
+    check(!runManifest("id,tsp,algorithm\n1," + tsp + ",ls,extra\n", rejected), "a row with more cells than the header is rejected");
+    check(!runManifest("id=1 tsp=" + tsp + " algorithm=nothing\n", rejected), "an unknown algorithm is rejected");
+    check(!runManifest("id=1 algorithm=ls\n", rejected), "a job without a problem is rejected");
+    check(!runManifest("# Nothing\n", rejected), "a manifest without jobs is rejected");
+
+    return testStatus();
+}
@@ -0,0 +1,87 @@
+/**
+ * @file test_concurrency.cpp
+ * @brief Check that concurrent solves give the same tours as sequential ones
+ * @date October 19, 2026
+ *
+ * Every algorithm is run twice (two seeds) on a shared problem, first one
+ * solve after another and then all of them at once, each on a thread of its
+ * own. Tours must not depend on what runs beside them. Built with
+ * -fsanitize=thread, the same program checks that solves share no mutable
+ * state without synchronization.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include "tsp.h"
+#include "check.h"
+
+#define TEST_SEEDS 2    ///< Solves of each algorithm
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::vector;
+
+/// Algorithms under test, one of each family
+static const char *ALGORITHMS[] = {
+    "greedy", "rs", "ls", "vnd", "sa", "greedyls", "greedyls+", "bmb",
+    "grasp", "grasp+", "ils", "vns", "ga", "ma", "psa", "pga"
+};
+
+/// A solve and its results
+struct Job {
+    const char *name;               ///< Name of the algorithm
+    Algorithms::Settings settings;
+    Tsp::Result expected;           ///< Result of the sequential solve
+    Tsp::Result result;             ///< Result of the concurrent solve
+};
+
+int main()
+{
+    Tsp::Problem problem;
+    vector<Job> jobs;
+    vector<std::thread> threads;
+
+    if (!problem.load(TSP_DATA_DIR "/berlin52.tsp"))
+        return EXIT_FAILURE;
+
+    for (size_t i = 0; i < sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]); i++) {
+        Algorithms::Algorithm algorithm;
+
+        if (!Algorithms::parse(ALGORITHMS[i], algorithm)) {
+            cerr << "Unknown algorithm " << ALGORITHMS[i] << endl;
+            return EXIT_FAILURE;
+        }
+
+        for (unsigned int seed = 1; seed <= TEST_SEEDS; seed++) {
+            Job job;
+
+            job.name = ALGORITHMS[i];
+            job.settings = Algorithms::Settings(algorithm, seed);
+            jobs.push_back(job);
+        }
+    }
+
+    for (size_t i = 0; i < jobs.size(); i++)
+        jobs[i].expected = problem.solve(jobs[i].settings);
+
+    for (size_t i = 0; i < jobs.size(); i++)
+        threads.push_back(std::thread([&problem, &jobs, i]() { jobs[i].result = problem.solve(jobs[i].settings); }));
+
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const Job &job = jobs[i];
+
+        check(job.expected.solved && job.result.solved && job.result.tour == job.expected.tour && job.result.cost == job.expected.cost,
+              string(job.name) + ", seed " + std::to_string(job.settings.seed) + ": " + std::to_string(job.result.cost) + " concurrently, " + std::to_string(job.expected.cost) + " alone");
+    }
+
+    cout << jobs.size() << " concurrent solves, " << (failures == 0 ? "same tours as sequential ones" : "some tours differ") << endl;
+    return testStatus();
+}
@@ -0,0 +1,61 @@
+/**
+ * @file test_deadline.cpp
+ * @brief Check time limits and interruptions
+ * @date October 19, 2026
+ *
+ * An interruption must stop the searches in progress, but not those started
+ * afterwards in the same process.
+ */
+
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include "tsp.h"
+#include "check.h"
+
+#define TEST_LIMIT 50   ///< Milliseconds of the limited deadline
+
+using Algorithms::Deadline;
+
+int main()
+{
+    Tsp::Problem problem;
+    Algorithms::Settings settings(Algorithms::LS, 1);
+
+    if (!problem.load(TSP_DATA_DIR "/berlin52.tsp"))
+        return EXIT_FAILURE;
+
+    const Tsp::Result expected = problem.solve(settings);
+
+    // Time limit
+
+    Deadline limited(TEST_LIMIT);
+
+    check(!limited.expired(), "a deadline is not expired when created");
+    std::this_thread::sleep_for(std::chrono::milliseconds(TEST_LIMIT * 2));
+
+    bool expired = false;
+
+    for (int i = 0; i < 1000 && !expired; i++)
+        expired = limited.expired();
+
+    check(expired, "a deadline expires after its limit");
+
+    // Interruptions
+
+    Deadline before;
+    const unsigned long interruptions = Deadline::interruptions();
+
+    Deadline::interrupt();
+    Deadline after;
+
+    check(Deadline::interruptions() == interruptions + 1, "interruptions are counted");
+    check(before.expired(), "an interruption stops the searches in progress");
+    check(!after.expired(), "an interruption does not stop later searches");
+
+    const Tsp::Result result = problem.solve(settings);
+
+    check(result.solved && result.tour == expected.tour && result.cost == expected.cost, "a solve after an interruption runs in full");
+
+    return testStatus();
+}
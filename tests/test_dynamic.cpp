@@ -0,0 +1,177 @@
+/**
+ * @file test_dynamic.cpp
+ * @brief Check the edits of a problem against an instance loaded anew
+ * @date October 19, 2026
+ *
+ * Cities are inserted, removed and moved in a problem, with every layout of
+ * the distance matrix. After each edit, the distances and the candidate
+ * lists must be those of an instance loaded from the same points, and the
+ * tour must remain a permutation with the right cost.
+ */
+
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include "tsp.h"
+#include "synthetic.h"
+#include "algorithms.h"
+#include "check.h"
+
+#define TEST_CITIES 200     ///< Cities before the edits
+#define TEST_EDITS 60       ///< Edits of each layout
+#define TEST_SIDE 1000.0    ///< Side of the square of the cities
+
+using std::string;
+using std::vector;
+
+/// Layouts under test
+static const struct {
+    const char *name;
+    Instance::Layout layout;
+} layouts[] = {
+    { "packed", Instance::Packed },
+    { "square", Instance::Square },
+    { "tiled", Instance::Tiled }
+};
+
+/**
+ * @brief Compare a problem with an instance loaded from its points
+ * @param problem Edited problem.
+ * @param points Points the problem must hold.
+ * @param tour Tour kept along the edits.
+ * @param layout Layout of the distance matrix.
+ * @return Description of the first difference, or NULL if there is none.
+ */
+static const char * compare(const Tsp::Problem &problem, const vector<Tsp::Point> &points, const vector<int> &tour, Instance::Layout layout)
+{
+    const Instance &edited = *problem.getCycle().getInstance();
+    const int size = (int)points.size();
+    vector<bool> seen(size, false);
+    vector<int> nodes(size, -1);
+    Instance fresh;
+    float cost = 0;
+
+    if (!fresh.loadVertices(points.data(), size, layout))
+        return "the points cannot be loaded";
+
+    if (edited.getSize() != size || problem.getSize() != size || (int)tour.size() != size)
+        return "wrong number of cities";
+
+    // A removal gives the index of the city to the last node, but keeps the
+    // numbers of the cities in order
+
+    for (int n = 0; n < size; n++) {
+        const int city = edited.idOf(n);
+
+        if (city < 0 || city >= size || nodes[city] >= 0)
+            return "the numbers of the cities are not a permutation";
+
+        nodes[city] = n;
+    }
+
+    for (int i = 0; i < size; i++) {
+        if (edited.vertexAt(nodes[i]).x != points[i].x || edited.vertexAt(nodes[i]).y != points[i].y)
+            return "wrong coordinates";
+
+        for (int j = 0; j < size; j++) {
+            if (edited.distance(nodes[i], nodes[j]) != fresh.distance(i, j))
+                return "wrong distances";
+        }
+    }
+
+    // Ties may be listed in another order, so the distances are compared
+
+    const int count = edited.getNeighbors();
+    const int *rows = edited.neighbors();
+    const int *freshRows = fresh.neighbors();
+
+    if (count != fresh.getNeighbors())
+        return "wrong length of the candidate lists";
+
+    for (int i = 0; i < size; i++) {
+        for (int k = 0; k < count; k++) {
+            const int node = rows[(size_t)nodes[i] * count + k];
+
+            if (node < 0 || node >= size || node == nodes[i])
+                return "candidate out of range";
+
+            if (fresh.distance(i, edited.idOf(node)) != fresh.distance(i, freshRows[(size_t)i * count + k]))
+                return "wrong candidate lists";
+        }
+    }
+
+    for (int i = 0; i < size; i++) {
+        if (tour[i] < 0 || tour[i] >= size || seen[tour[i]])
+            return "the tour is not a permutation";
+
+        seen[tour[i]] = true;
+        cost += fresh.distance(tour[i], tour[(i + 1) % size]);
+    }
+
+    if (fabs(problem.cost(tour) - cost) > 1e-3f * cost)
+        return "wrong cost of the tour";
+
+    return NULL;
+}
+
+int main()
+{
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+        Tsp::Synthetic synthetic(Tsp::Synthetic::Uniform, TEST_CITIES + TEST_EDITS, 1, TEST_SIDE);
+        Algorithms::Generator generator(1);
+        vector<Tsp::Point> points;
+        vector<int> tour;
+        Tsp::Point point;
+        Tsp::Problem problem;
+
+        for (int i = 0; i < TEST_CITIES && synthetic.next(point); i++)
+            points.push_back(point);
+
+        for (int i = 0; i < TEST_CITIES; i++)
+            tour.push_back(i);
+
+        if (!problem.load(points, layouts[l].layout))
+            return EXIT_FAILURE;
+
+        // The lists are built before the edits, so that they are updated
+
+        problem.getCycle().getInstance()->neighbors();
+
+        for (int e = 0; e < TEST_EDITS; e++) {
+            const int city = Algorithms::random(generator, (int)points.size());
+            const char *edit;
+            bool done;
+
+            synthetic.next(point);
+
+            switch (e % 3) {
+            case 0:
+                edit = "insert";
+                done = problem.insert(point, tour) == (int)points.size();
+                points.push_back(point);
+                break;
+
+            case 1:
+                edit = "remove";
+                done = problem.remove(city, tour);
+                points.erase(points.begin() + city);
+                break;
+
+            default:
+                edit = "move";
+                done = problem.move(city, point, tour);
+                points[city] = point;
+            }
+
+            const char *error = done ? compare(problem, points, tour, layouts[l].layout) : "the edit failed";
+
+            if (error != NULL) {
+                check(false, string(layouts[l].name) + ", " + edit + " #" + std::to_string(e) + ": " + error);
+                break;
+            }
+        }
+    }
+
+    return testStatus();
+}
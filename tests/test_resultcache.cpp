@@ -0,0 +1,98 @@
+/**
+ * @file test_resultcache.cpp
+ * @brief Check the hits, misses and keys of the result cache
+ * @date October 19, 2026
+ */
+
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <unistd.h>
+#include "tsp.h"
+#include "resultcache.h"
+#include "check.h"
+
+#define TEST_INSTANCE TSP_DATA_DIR "/berlin52.tsp"
+#define TEST_CAPACITY (256L << 20)  ///< Capacity of the cache
+
+using std::string;
+
+/**
+ * @brief Remove a directory and its files
+ * @param path Directory.
+ */
+static void removeAll(const string &path)
+{
+    DIR *dir = opendir(path.c_str());
+    struct dirent *entry;
+
+    if (dir == NULL)
+        return;
+
+    while ((entry = readdir(dir)) != NULL) {
+        if (string(entry->d_name) != "." && string(entry->d_name) != "..")
+            unlink((path + "/" + entry->d_name).c_str());
+    }
+
+    closedir(dir);
+    rmdir(path.c_str());
+}
+
+int main()
+{
+    char directory[] = "/tmp/tsp_cacheXXXXXX";
+    Tsp::Problem problem;
+    Tsp::Problem hilbert;
+    Cycle original;
+    Cycle reordered;
+    Algorithms::Settings settings(Algorithms::Genetic, 1);
+    Algorithms::Settings limited = settings;
+    Algorithms::Settings other(Algorithms::Genetic, 2);
+
+    if (mkdtemp(directory) == NULL)
+        return EXIT_FAILURE;
+
+    Tsp::ResultCache cache(directory, TEST_CAPACITY);
+
+    if (!cache.open() || !problem.load(TEST_INSTANCE) || !hilbert.load(TEST_INSTANCE, Instance::Packed, Instance::Hilbert)) {
+        removeAll(directory);
+        return EXIT_FAILURE;
+    }
+
+    // Keys: the time limit is left out, the seed and the numbering are not
+
+    original.loadTsp(TEST_INSTANCE);
+    reordered.loadTsp(TEST_INSTANCE, Instance::Packed, Instance::Hilbert);
+    limited.timeLimit = 1000;
+
+    check(Tsp::ResultCache::key(original, settings) == Tsp::ResultCache::key(original, limited), "the time limit does not change the key");
+    check(Tsp::ResultCache::key(original, settings) != Tsp::ResultCache::key(original, other), "the seed changes the key");
+    check(Tsp::ResultCache::key(original, settings) != Tsp::ResultCache::key(reordered, settings), "--order changes the key");
+
+    // Miss, then hit with the same tour
+
+    const Tsp::Result first = problem.solve(settings, &cache);
+    const Tsp::Result second = problem.solve(settings, &cache);
+
+    check(first.solved && !first.cached, "the first solve is a miss");
+    check(second.solved && second.cached, "the same solve is a hit");
+    check(second.tour == first.tour && second.cost == first.cost, "a hit returns the stored tour");
+
+    // Other settings, or the same settings on another numbering, miss
+
+    const Tsp::Result seeded = problem.solve(other, &cache);
+    const Tsp::Result renumbered = hilbert.solve(settings, &cache);
+
+    check(seeded.solved && !seeded.cached, "another seed is a miss");
+    check(renumbered.solved && !renumbered.cached, "another --order is a miss");
+    check(hilbert.solve(settings, &cache).cached, "another --order is stored apart");
+
+    // The best tour of the instance is kept, whatever the settings and the numbering
+
+    check(cache.best(original) && original.getCost() == std::min(std::min(first.cost, seeded.cost), renumbered.cost), "the best tour is kept");
+
+    removeAll(directory);
+    return testStatus();
+}
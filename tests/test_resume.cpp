@@ -0,0 +1,137 @@
+/**
+ * @file test_resume.cpp
+ * @brief Check that resumed searches end as if they were never stopped
+ * @date October 19, 2026
+ *
+ * Each search that saves checkpoints is run once in full, and once stopped
+ * by a time limit and resumed from its checkpoint, as tsp --resume does. Both
+ * must give the same tour and cost. Checkpoints are taken every millisecond,
+ * so that one is saved at the start of almost every step, and at a long
+ * interval, so that only the state saved when the search stops is resumed.
+ */
+
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <unistd.h>
+#include "cycle.h"
+#include "algorithms.h"
+#include "checkpoint.h"
+#include "check.h"
+
+#define TEST_LIMIT 100  ///< Milliseconds before the first run is stopped
+
+using std::string;
+
+/// Searches under test, long enough to be stopped by TEST_LIMIT and far enough
+/// from converging that a wrong state changes their result
+static const struct {
+    const char *name;
+    bool large;             ///< Run on a280 rather than kroA100
+    Algorithms::Algorithm algorithm;
+    int count;
+    Algorithms::Crossover crossover;
+    bool warm;              ///< Start from the greedy tour
+} searches[] = {
+    { "sa", true, Algorithms::SA, 12000, Algorithms::Segment, false },
+    { "sa -c", true, Algorithms::SA, 12000, Algorithms::Segment, true },
+    { "ga", true, Algorithms::Genetic, 400, Algorithms::Segment, false },
+    { "ga -x eax", true, Algorithms::Genetic, 8, Algorithms::EAX, false },
+    { "ma", false, Algorithms::Memetic, 20, Algorithms::Segment, false },
+    { "ma -c", false, Algorithms::Memetic, 20, Algorithms::Segment, true },
+    { "psa", true, Algorithms::ParallelSA, 2500, Algorithms::Segment, false },
+    { "pga", true, Algorithms::ParallelGenetic, 12, Algorithms::Segment, false }
+};
+
+/// Milliseconds between checkpoints
+static const long INTERVALS[] = { 1, 100000 };
+
+/**
+ * @brief Compare two tours
+ * @return Whether they have the same path and the same cost.
+ */
+static bool same(const Cycle &a, const Cycle &b)
+{
+    if (a.getSize() != b.getSize() || a.getCost() != b.getCost())
+        return false;
+
+    for (int i = 0; i < a.getSize(); i++)
+        if (a.edgeAt(i) != b.edgeAt(i))
+            return false;
+
+    return true;
+}
+
+int main()
+{
+    char path[] = "/tmp/tsp_resumeXXXXXX";
+    const int fd = mkstemp(path);
+    Cycle small, large, smallStart, largeStart;
+
+    if (fd < 0)
+        return EXIT_FAILURE;
+
+    close(fd);
+
+    if (!small.loadTsp(TSP_DATA_DIR "/kroA100.tsp") || !large.loadTsp(TSP_DATA_DIR "/a280.tsp")) {
+        unlink(path);
+        return EXIT_FAILURE;
+    }
+
+    smallStart = small;
+    largeStart = large;
+    Algorithms::greedy(smallStart);
+    Algorithms::greedy(largeStart);
+
+    for (size_t s = 0; s < sizeof(searches) / sizeof(searches[0]); s++) {
+        const string name = searches[s].name;
+        const Cycle &sample = searches[s].large ? large : small;
+        const Cycle &start = searches[s].large ? largeStart : smallStart;
+        Algorithms::Settings settings(searches[s].algorithm, 1);
+        Cycle full(searches[s].warm ? start : sample);
+
+        settings.count = searches[s].count;
+        settings.crossover = searches[s].crossover;
+        settings.warmStart = searches[s].warm;
+
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        Algorithms::solve(full, settings);
+        const long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+
+        check(elapsed > 2 * TEST_LIMIT, name + " lasts longer than the time limit");
+
+        for (size_t i = 0; i < sizeof(INTERVALS) / sizeof(INTERVALS[0]); i++) {
+            const string run = name + ", checkpoints every " + std::to_string(INTERVALS[i]) + " ms";
+            Algorithms::Settings limited = settings;
+            Cycle stopped(searches[s].warm ? start : sample);
+            Cycle resumed(sample);
+
+            limited.timeLimit = TEST_LIMIT;
+            unlink(path);
+
+            // The destructors wait for the last write
+
+            {
+                Algorithms::Checkpoint checkpoint(path, INTERVALS[i], limited);
+                Algorithms::solve(stopped, limited, &checkpoint);
+            }
+
+            {
+                Algorithms::Checkpoint checkpoint(path, INTERVALS[i], Algorithms::Settings());
+
+                if (!checkpoint.load(path, resumed)) {
+                    check(false, run + ": the checkpoint is loaded");
+                    continue;
+                }
+
+                check(checkpoint.getStart(resumed) == searches[s].warm, run + ": the starting tour is kept");
+                Algorithms::solve(resumed, checkpoint.getSettings(), &checkpoint);
+            }
+
+            check(same(resumed, full), run + ": the resumed search gives the same tour");
+        }
+    }
+
+    unlink(path);
+    return testStatus();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file test_synthetic.cpp
+ * @brief Check the generator of synthetic instances
+ * @date October 19, 2026
+ *
+ * Point sets must depend on the seed only, have the requested size, read
+ * back the same from a TSPLIB file, and the optimum of a grid must be the
+ * length of its comb tour.
+ */
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+#include "synthetic.h"
+#include "cycle.h"
+#include "check.h"
+
+#define TEST_COUNT 1000     ///< Points of each set
+#define TEST_SIDE 1000.0    ///< Side of the square of the points
+#define TEST_GRID 6         ///< Side of the grid, in points (even)
+
+using std::string;
+using std::vector;
+
+/// Distributions under test
+static const char *DISTRIBUTIONS[] = { "uniform", "clustered", "grid", "road" };
+
+/**
+ * @brief Compare two point sets
+ * @return Whether they hold the same points in the same order.
+ */
+static bool same(const vector<Tsp::Point> &a, const vector<Tsp::Point> &b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i].x != b[i].x || a[i].y != b[i].y)
+            return false;
+
+    return true;
+}
+
+int main()
+{
+    Tsp::Synthetic::Distribution distribution;
+
+    check(!Tsp::Synthetic::parse("gaussian", distribution), "unknown names are rejected");
+
+    for (size_t d = 0; d < sizeof(DISTRIBUTIONS) / sizeof(DISTRIBUTIONS[0]); d++) {
+        const string name = DISTRIBUTIONS[d];
+
+        if (!Tsp::Synthetic::parse(name.c_str(), distribution)) {
+            check(false, name + " is a distribution");
+            continue;
+        }
+
+        const vector<Tsp::Point> points = Tsp::Synthetic(distribution, TEST_COUNT, 7, TEST_SIDE).points();
+        const vector<Tsp::Point> again = Tsp::Synthetic(distribution, TEST_COUNT, 7, TEST_SIDE).points();
+        const vector<Tsp::Point> other = Tsp::Synthetic(distribution, TEST_COUNT, 8, TEST_SIDE).points();
+
+        check(points.size() == TEST_COUNT, name + " gives the requested number of points");
+        check(same(points, again), name + " gives the same points for the same seed");
+        check(distribution == Tsp::Synthetic::Grid || !same(points, other), name + " gives other points for another seed");
+
+        // The file reads back with the same coordinates
+
+        char path[] = "/tmp/tsp_syntheticXXXXXX";
+        const int fd = mkstemp(path);
+        Cycle loaded;
+
+        if (fd < 0)
+            return EXIT_FAILURE;
+
+        close(fd);
+
+        const bool written = Tsp::Synthetic(distribution, TEST_COUNT, 7, TEST_SIDE).write(path, name.c_str());
+
+        check(written && loaded.loadTsp(path) && loaded.getSize() == TEST_COUNT, name + " writes a TSPLIB file");
+
+        for (int i = 0; written && i < loaded.getSize(); i++) {
+            if (loaded.vertexAt(i).x != points[i].x || loaded.vertexAt(i).y != points[i].y) {
+                check(false, name + " writes every digit of the coordinates");
+                break;
+            }
+        }
+
+        unlink(path);
+    }
+
+    // A grid with an even side is crossed by a comb tour of unit steps
+
+    const int count = TEST_GRID * TEST_GRID;
+    Tsp::Synthetic grid(Tsp::Synthetic::Grid, count, 1, TEST_SIDE);
+    const vector<Tsp::Point> points = Tsp::Synthetic(Tsp::Synthetic::Grid, count, 1, TEST_SIDE).points();
+    vector<int> tour;
+    Instance instance;
+    double length = 0;
+
+    for (int x = 0; x < TEST_GRID; x++)
+        tour.push_back(x);
+
+    for (int y = 1; y < TEST_GRID; y++) {
+        for (int x = 1; x < TEST_GRID; x++)
+            tour.push_back(y * TEST_GRID + (y % 2 ? TEST_GRID - x : x));
+    }
+
+    for (int y = TEST_GRID - 1; y > 0; y--)
+        tour.push_back(y * TEST_GRID);
+
+    if (!instance.loadVertices(points.data(), count))
+        return EXIT_FAILURE;
+
+    for (int i = 0; i < count; i++)
+        length += instance.distance(tour[i], tour[(i + 1) % count]);
+
+    check(grid.optimum() > 0 && length == grid.optimum(), "the optimum of a grid is its comb tour");
+    check(Tsp::Synthetic(Tsp::Synthetic::Grid, (TEST_GRID + 1) * (TEST_GRID + 1), 1).optimum() == 0, "the optimum of a grid with an odd side is unknown");
+    check(Tsp::Synthetic(Tsp::Synthetic::Grid, count - 1, 1).optimum() == 0, "the optimum of an incomplete grid is unknown");
+    check(Tsp::Synthetic(Tsp::Synthetic::Uniform, count, 1).optimum() == 0, "the optimum of random points is unknown");
+
+    return testStatus();
+}